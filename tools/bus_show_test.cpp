@@ -0,0 +1,92 @@
+/*
+ * Host test for non-blocking bus frame hand-off (wled00/bus_show.h) using fake buses with emulated wire time
+ * build & run: g++ -O2 -std=c++17 -o /tmp/bus_show_test tools/bus_show_test.cpp && /tmp/bus_show_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "../wled00/bus_show.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+static uint32_t now = 0; // simulated time in us
+
+// behaves like a DMA/RMT driven NeoPixelBus: show() copies the back buffer and returns, canShow() is false while sending
+struct FakeBus {
+  uint32_t wireTime;
+  uint32_t txStart = 0;
+  bool     pending = false;
+  bool     busy = false;
+  unsigned backFrame = 0; // frame number currently in back buffer
+  unsigned sentFrame = 0; // last frame number put on the wire
+  unsigned sent = 0;
+  explicit FakeBus(uint32_t w) : wireTime(w) {}
+  bool canShow() const           { return !busy || now - txStart >= wireTime; }
+  void show()                    { if (!canShow()) failures++, printf("FAIL: show() while sending\n"); busy = true; txStart = now; sentFrame = backFrame; sent++; }
+  bool isShowPending() const     { return pending; }
+  void setShowPending(bool p)    { pending = p; }
+};
+
+static unsigned events[5];
+static void trace(uint8_t e, uint8_t) { events[e]++; }
+
+// runs for duration us: paints a frame every encodeTime us (loop() calls service() every pollTime us in between)
+// blocking emulates the old behaviour (show() waits for previous frame to finish)
+static unsigned simulate(FakeBus *buses, unsigned n, uint32_t encodeTime, uint32_t pollTime, uint32_t duration, bool blocking) {
+  uint32_t sending = 0;
+  unsigned frame = 0;
+  now = 0;
+  uint32_t nextFrame = encodeTime;
+  while (now < duration) {
+    if (now >= nextFrame) {
+      frame++;
+      for (unsigned i = 0; i < n; i++) {
+        if (blocking) while (!buses[i].canShow()) now++;
+        buses[i].backFrame = frame;
+        busShowFrame(buses[i], i, sending, trace);
+      }
+      nextFrame = now + encodeTime;
+    }
+    now += pollTime;
+    for (unsigned i = 0; i < n; i++) busServiceFrame(buses[i], i, sending, trace);
+  }
+  // drain: last painted frame must reach the wire
+  for (unsigned t = 0; t < 100000 && (sending || buses[0].pending); t++) {
+    now += pollTime;
+    for (unsigned i = 0; i < n; i++) busServiceFrame(buses[i], i, sending, trace);
+  }
+  for (unsigned i = 0; i < n; i++) CHECK(buses[i].sentFrame == frame, "bus %u last frame %u sent %u", i, frame, buses[i].sentFrame);
+  CHECK(sending == 0, "sending mask 0x%x after drain", sending);
+  return frame;
+}
+
+int main() {
+  // 300 WS2812 LEDs: 9 ms on the wire; encode 6 ms; loop() polls every 200 us; 10 s
+  const uint32_t wire = 300 * 30, encode = 6000, poll = 200, duration = 10000000;
+
+  FakeBus a[2] = { FakeBus(wire), FakeBus(wire / 2) };
+  unsigned framesBlocking = simulate(a, 2, encode, poll, duration, true);
+  FakeBus b[2] = { FakeBus(wire), FakeBus(wire / 2) };
+  for (unsigned &e : events) e = 0;
+  unsigned framesDeferred = simulate(b, 2, encode, poll, duration, false);
+  CHECK(events[BUS_TRACE_TX_DEFER] > 0, "no frame was deferred");
+  CHECK(events[BUS_TRACE_TX_DONE] > 0, "no completion detected");
+  // painting is no longer throttled by the slowest bus: painted FPS bound by encode time, not wire time
+  CHECK(framesDeferred > framesBlocking * 4 / 3, "deferred %u vs blocking %u frames", framesDeferred, framesBlocking);
+  // slow bus can never send more than its wire time allows, fast bus sends every painted frame
+  CHECK(b[0].sent <= duration / wire + 2, "bus 0 sent %u frames", b[0].sent);
+  CHECK(b[1].sent == framesDeferred, "bus 1 sent %u of %u frames", b[1].sent, framesDeferred);
+  printf("painted FPS: blocking %.1f, deferred %.1f (bus 0 sent %u, bus 1 sent %u frames)\n",
+    framesBlocking * 1e6 / duration, framesDeferred * 1e6 / duration, b[0].sent, b[1].sent);
+
+  // all 32 mask bits are usable (WLED_MAX_BUSSES <= 32 is asserted in bus_manager.cpp)
+  static FakeBus many[32] = { FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100),
+                              FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100),
+                              FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100),
+                              FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100), FakeBus(100) };
+  simulate(many, 32, 50, 10, 100000, false);
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,148 @@
+import json
+import socket
+import statistics
+import struct
+import time
+import urllib.request
+
+# binary control protocol, see handleControlPacket() in wled00/udp.cpp
+CONTROL_PROTOCOL_ID = 0xC5
+CTRL_ALL_SELECTED = 255
+FIELDS = {
+    'bri': 0x01, 'seg_bri': 0x02, 'on': 0x03, 'sx': 0x04, 'ix': 0x05,
+    'c1': 0x06, 'c2': 0x07, 'c3': 0x08, 'pal': 0x09, 'fx': 0x0A,
+    'col1': 0x0B, 'col2': 0x0C, 'col3': 0x0D,
+}
+COLOR_FIELDS = ('col1', 'col2', 'col3')
+
+
+def encode(segment=CTRL_ALL_SELECTED, **values):
+    """Encodes field values (name=int or name=(r,g,b,w) for colors) into a control message."""
+    data = bytearray([CONTROL_PROTOCOL_ID, segment])
+    for name, value in values.items():
+        data.append(FIELDS[name])
+        if name in COLOR_FIELDS:
+            data.extend(struct.pack('4B', *value))
+        else:
+            data.append(value)
+    return bytes(data)
+
+
+def decode(data):
+    """Mirrors the firmware parser: returns (segment, {name: value}) or None if not a control message."""
+    if len(data) < 2 or data[0] != CONTROL_PROTOCOL_ID:
+        return None
+    names = {v: k for k, v in FIELDS.items()}
+    values = {}
+    i = 2
+    while i < len(data):
+        field = data[i]
+        i += 1
+        if field not in names:
+            break
+        size = 4 if names[field] in COLOR_FIELDS else 1
+        if i + size > len(data):
+            break
+        values[names[field]] = tuple(data[i:i+size]) if size == 4 else data[i]
+        i += size
+    return data[1], values
+
+
+class WledControlClient:
+    def __init__(self, wled_controller_ip, udp_port=21324):
+        self.wled_controller_ip = wled_controller_ip
+        self.udp_port = udp_port
+        self._sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+
+    def send(self, segment=CTRL_ALL_SELECTED, **values):
+        self._sock.sendto(encode(segment, **values), (self.wled_controller_ip, self.udp_port))
+
+
+def self_test():
+    msg = encode(1, bri=128, sx=200, col1=(255, 0, 16, 0), c3=31)
+    assert msg == bytes([0xC5, 1, 0x01, 128, 0x04, 200, 0x0B, 255, 0, 16, 0, 0x08, 31])
+    assert decode(msg) == (1, {'bri': 128, 'sx': 200, 'col1': (255, 0, 16, 0), 'c3': 31})
+    assert decode(msg[:-1]) == (1, {'bri': 128, 'sx': 200, 'col1': (255, 0, 16, 0)})  # truncated value is dropped
+    assert decode(bytes([0xC5, 0, 0x7F, 1, 0x01, 2])) == (0, {})  # parsing stops at unknown field
+    assert decode(b'{"on":true}') is None
+    print('Encoder/decoder self test passed')
+
+
+################################## latency benchmark ##################################
+# there is no reply to control messages: the time until a change shows up in /json/state is measured instead
+# (includes one poll round trip, which is reported separately as baseline)
+def get_speed(ip):
+    with urllib.request.urlopen(f'http://{ip}/json/state', timeout=2) as r:
+        state = json.load(r)
+    segs = [s for s in state.get('seg', []) if s.get('sel')] or state.get('seg', [])
+    return segs[0]['sx'] if segs else None
+
+
+def measure(ip, send, samples):
+    results = []
+    for n in range(samples):
+        v = (get_speed(ip) + 1 + n % 100) % 256  # always a different value
+        start = time.perf_counter()
+        send(v)
+        while get_speed(ip) != v:
+            if time.perf_counter() - start > 2:
+                break
+        else:
+            results.append((time.perf_counter() - start) * 1000)
+        time.sleep(0.05)
+    return results
+
+
+def report(name, results, samples):
+    if not results:
+        print(f'{name:>12}: no change seen (is "Receive UDP realtime" enabled?)')
+        return
+    results.sort()
+    p95 = results[min(len(results) - 1, int(len(results) * 0.95))]
+    print(f'{name:>12}: median {statistics.median(results):6.1f} ms, p95 {p95:6.1f} ms, min {results[0]:6.1f} ms ({len(results)}/{samples})')
+
+
+def latency_test(ip, samples):
+    wled = WledControlClient(ip)
+    udp = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    def post(v):
+        req = urllib.request.Request(f'http://{ip}/json/state', data=json.dumps({'seg': {'sx': v}}).encode(),
+                                     headers={'Content-Type': 'application/json'})
+        urllib.request.urlopen(req, timeout=2).read()
+    polls = []
+    for _ in range(samples):
+        start = time.perf_counter()
+        get_speed(ip)
+        polls.append((time.perf_counter() - start) * 1000)
+    report('poll (base)', polls, samples)
+    report('binary UDP', measure(ip, lambda v: wled.send(sx=v), samples), samples)
+    report('JSON UDP', measure(ip, lambda v: udp.sendto(json.dumps({'seg': {'sx': v}}).encode(), (ip, wled.udp_port)), samples), samples)
+    report('JSON HTTP', measure(ip, post, samples), samples)
+
+
+################################## fader sweep test ##################################
+if __name__ == "__main__":
+    import sys
+    self_test()
+    if len(sys.argv) < 2:
+        print('Usage: control_test.py <ip> [messages/s] [seconds]')
+        print('       control_test.py <ip> latency [samples]')
+        sys.exit(0)
+    if len(sys.argv) > 2 and sys.argv[2] == 'latency':
+        samples = int(sys.argv[3]) if len(sys.argv) > 3 else 50
+        print(f'Measuring speed change latency, {samples} samples per method')
+        latency_test(sys.argv[1], samples)
+        sys.exit(0)
+    rate = float(sys.argv[2]) if len(sys.argv) > 2 else 100
+    duration = float(sys.argv[3]) if len(sys.argv) > 3 else 10
+    wled = WledControlClient(sys.argv[1])
+    print(f'Sweeping speed and intensity at {rate:.0f} messages/s for {duration:g} s')
+    sent = 0
+    start = time.perf_counter()
+    while time.perf_counter() - start < duration:
+        v = sent % 256
+        wled.send(sx=v, ix=255 - v)
+        sent += 1
+        time.sleep(max(0, start + sent / rate - time.perf_counter()))
+    elapsed = time.perf_counter() - start
+    print(f'{sent} messages in {elapsed:.2f} s: {sent / elapsed:.1f} messages/s')
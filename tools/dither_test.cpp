@@ -0,0 +1,70 @@
+/*
+ * Host test and benchmark for temporal dithering of bus brightness (wled00/dither.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/dither_test tools/dither_test.cpp && /tmp/dither_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include "../wled00/dither.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+static uint8_t channel(uint32_t c, unsigned i) { return (c >> (i*8)) & 0xFF; }
+
+int main() {
+  // brightness 0 is always black (no glow from thresholds or accumulated error)
+  for (unsigned t = 0; t < 4; t++) {
+    uint8_t err[4] = { 255, 255, 255, 255 };
+    CHECK(colorFadeDither(0xFFFFFFFF, 0, nullptr, &_ditherPattern[t]) == 0, "bri 0 ordered frame %u", t);
+    CHECK(colorFadeDither(0xFFFFFFFF, 0, err, nullptr) == 0, "bri 0 error diffusion frame %u", t);
+  }
+
+  // average of 4 ordered frames and of 256 error diffusion frames matches the exact product
+  for (unsigned bri = 1; bri < 255; bri++) {
+    for (unsigned v = 0; v < 256; v++) {
+      const uint32_t c = v * 0x01010101U;
+      const double exact = v * (bri + 1) / 256.0;
+      unsigned sumOrdered = 0, sumError = 0;
+      uint8_t err[4] = { 0, 0, 0, 0 };
+      for (unsigned f = 0; f < 4; f++) sumOrdered += channel(colorFadeDither(c, bri, nullptr, &_ditherPattern[f]), 0);
+      for (unsigned f = 0; f < 256; f++) sumError += channel(colorFadeDither(c, bri, err, nullptr), 1);
+      if (exact >= 1.0) { // below 1 the "stays on" rule applies
+        CHECK(sumOrdered / 4.0 - exact < 0.76 && exact - sumOrdered / 4.0 < 0.26, "ordered mean v=%u bri=%u: %.2f vs %.2f", v, bri, sumOrdered / 4.0, exact);
+        CHECK(sumError / 256.0 - exact < 0.01 && exact - sumError / 256.0 < 0.01, "error mean v=%u bri=%u: %.3f vs %.3f", v, bri, sumError / 256.0, exact);
+      }
+    }
+  }
+
+  // a channel that is on stays on (like color_fade(..., true)) unless negligible against the dominant channel
+  for (unsigned f = 0; f < 4; f++) {
+    uint32_t c = colorFadeDither(0x01020304, 1, nullptr, &_ditherPattern[f]);
+    for (unsigned i = 0; i < 4; i++) CHECK(channel(c, i) >= 1, "dim channel %u dropped to 0 (frame %u)", i, f);
+    c = colorFadeDither(0x00FF0001, 1, nullptr, &_ditherPattern[f]); // blue is < 1/32 of red
+    CHECK(channel(c, 0) == 0, "negligible channel kept (frame %u)", f);
+  }
+
+  // benchmark: plain scaling vs. dithering (ordered and error diffusion)
+  const unsigned N = 4096, R = 2000;
+  uint32_t *px = new uint32_t[N];
+  uint8_t *err = new uint8_t[N*4]();
+  for (unsigned i = 0; i < N; i++) px[i] = (uint32_t)rand() * 2654435761U;
+  volatile uint32_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < R; r++) for (unsigned i = 0; i < N; i++) {
+    const uint32_t c = px[i]; // color_fade(c, bri, false) equivalent
+    sink += ((((c & 0x00FF00FF) * 101) >> 8) & 0x00FF00FF) | ((((c >> 8) & 0x00FF00FF) * 101) & ~0x00FF00FF);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < R; r++) for (unsigned i = 0; i < N; i++) sink += colorFadeDither(px[i], 100, nullptr, &_ditherPattern[(r + i) & 3]);
+  auto t2 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < R; r++) for (unsigned i = 0; i < N; i++) sink += colorFadeDither(px[i], 100, &err[i*4], nullptr);
+  auto t3 = std::chrono::steady_clock::now();
+  const auto ns = [&](auto a, auto b) { return std::chrono::duration<double, std::nano>(b - a).count() / (double(N) * R); };
+  printf("ns/pixel: plain %.2f, ordered %.2f, error diffusion %.2f\n", ns(t0, t1), ns(t1, t2), ns(t2, t3));
+  delete[] px;
+  delete[] err;
+
+  printf(failures ? "%d checks failed\n" : "all checks passed\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * Host comparison and benchmark of the fixed point Julia and Rotozoomer kernels (WLED_FX_FIXEDPOINT, wled00/fx_julia.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/fx_fixedpoint_test tools/fx_fixedpoint_test.cpp && /tmp/fx_fixedpoint_test
+ * the host has an FPU, so the float kernels are also timed with a minimal software float (SoftFloat below, no NaN/inf/denormal
+ * handling, i.e. cheaper than the libgcc routines ESP8266, ESP32-C3 and ESP32-S2 use) to estimate chips without FPU
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "../wled00/fx_julia.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+// IEEE single precision in software: round half up, zero for underflow
+struct SoftFloat {
+  uint32_t v;
+  SoftFloat() : v(0) {}
+  SoftFloat(float f) { memcpy(&v, &f, 4); }
+  explicit SoftFloat(int i) : SoftFloat((float)i) {}
+  float f() const { float r; memcpy(&r, &v, 4); return r; }
+  static SoftFloat bits(uint32_t b) { SoftFloat s; s.v = b; return s; }
+  static SoftFloat pack(uint32_t sign, int32_t exp, uint64_t man, int shift) { // man has its leading one at bit 23 + shift
+    if (shift > 0) man = (man + (1ULL << (shift - 1))) >> shift;
+    else man <<= -shift;
+    if (man >> 24) { man >>= 1; exp++; }
+    if (exp <= 0 || man == 0) return bits(sign);
+    return bits(sign | (uint32_t)exp << 23 | (uint32_t)(man & 0x7FFFFF));
+  }
+  friend SoftFloat operator*(SoftFloat a, SoftFloat b) {
+    uint32_t sign = (a.v ^ b.v) & 0x80000000;
+    int32_t ea = (a.v >> 23) & 0xFF, eb = (b.v >> 23) & 0xFF;
+    if (!ea || !eb) return bits(sign);
+    uint64_t m = (uint64_t)((a.v & 0x7FFFFF) | 0x800000) * ((b.v & 0x7FFFFF) | 0x800000); // leading one at bit 46 or 47
+    int32_t exp = ea + eb - 127;
+    if (m >> 47) { exp++; return pack(sign, exp, m, 24); }
+    return pack(sign, exp, m, 23);
+  }
+  friend SoftFloat operator+(SoftFloat a, SoftFloat b) {
+    if ((a.v & 0x7FFFFFFF) < (b.v & 0x7FFFFFFF)) { SoftFloat t = a; a = b; b = t; } // |a| >= |b|
+    int32_t ea = (a.v >> 23) & 0xFF, eb = (b.v >> 23) & 0xFF;
+    if (!eb) return a;
+    int64_t ma = (int64_t)((a.v & 0x7FFFFF) | 0x800000) << 8, mb = (int64_t)((b.v & 0x7FFFFF) | 0x800000) << 8;
+    int d = ea - eb;
+    mb = d > 40 ? 0 : mb >> d;
+    int64_t m = ((a.v ^ b.v) & 0x80000000) ? ma - mb : ma + mb;
+    if (m == 0) return SoftFloat();
+    int lead = 63 - __builtin_clzll(m); // leading one, 31 or 32 after addition, lower after subtraction
+    int32_t exp = ea + lead - 31;
+    return pack(a.v & 0x80000000, exp, m, lead - 23);
+  }
+  friend SoftFloat operator-(SoftFloat a, SoftFloat b) { b.v ^= 0x80000000; return a + b; }
+  friend bool operator>(SoftFloat a, SoftFloat b) { // sign-magnitude compare
+    int32_t x = a.v & 0x80000000 ? -(int32_t)(a.v & 0x7FFFFFFF) : (int32_t)a.v;
+    int32_t y = b.v & 0x80000000 ? -(int32_t)(b.v & 0x7FFFFFFF) : (int32_t)b.v;
+    return x > y;
+  }
+};
+
+// mode_2DJulia() frame set up at time t (ms) on a cols x rows segment
+struct JuliaFrame { float xmin, ymin, dx, dy, re, im; };
+static JuliaFrame juliaFrame(uint32_t t, int cols, int rows) {
+  // xcen/ycen/xymag as after the effect's defaults, c moves like reAl/imAg += sin16_t(now*34)/655340
+  float xmin = -0.6f, xmax = 0.6f, ymin = -0.6f, ymax = 0.6f;
+  JuliaFrame f;
+  f.re = -0.94299f + sinf(t * 34 * 6.2831853f / 65536) * 32767 / 655340.f;
+  f.im =  0.3162f  + sinf(t * 26 * 6.2831853f / 65536) * 32767 / 655340.f;
+  f.xmin = xmin; f.ymin = ymin;
+  f.dx = (xmax - xmin) / cols; f.dy = (ymax - ymin) / rows;
+  return f;
+}
+
+template<class F> static void juliaFloat(const JuliaFrame &fr, int cols, int rows, int maxIterations, uint8_t *out) {
+  F y = fr.ymin;
+  for (int j = 0; j < rows; j++) {
+    F x = fr.xmin;
+    for (int i = 0; i < cols; i++) {
+      out[j * cols + i] = juliaIterations<F>(x, y, F(fr.re), F(fr.im), maxIterations, F(16.0f));
+      x = x + F(fr.dx);
+    }
+    y = y + F(fr.dy);
+  }
+}
+
+static void juliaFixed(const JuliaFrame &fr, int cols, int rows, int maxIterations, uint8_t *out) {
+  const int32_t reQ = fr.re * (1 << JULIA_Q), imQ = fr.im * (1 << JULIA_Q);
+  const int32_t dxQ = fr.dx * (1 << JULIA_Q), dyQ = fr.dy * (1 << JULIA_Q);
+  const int64_t maxCalcQ = (int64_t)16 << (2 * JULIA_Q);
+  int32_t yQ = fr.ymin * (1 << JULIA_Q);
+  for (int j = 0; j < rows; j++) {
+    int32_t xQ = fr.xmin * (1 << JULIA_Q);
+    for (int i = 0; i < cols; i++) {
+      out[j * cols + i] = juliaIterationsQ(xQ, yQ, reQ, imQ, maxIterations, maxCalcQ);
+      xQ += dxQ;
+    }
+    yQ += dyQ;
+  }
+}
+
+// mode_2Dplasmarotozoom() source coordinates, float and Q16 (copied from FX.cpp)
+static inline uint8_t abs8(int8_t i) { return i < 0 ? -i : i; }
+template<class F> static void rotozoomFloat(F kosinus, F sinus, int cols, int rows, uint8_t *out) {
+  for (int i = 0; i < cols; i++) {
+    F u1 = F((float)i) * kosinus;
+    F v1 = F((float)i) * sinus;
+    for (int j = 0; j < rows; j++) {
+      uint8_t u = abs8((int8_t)(int)(u1 - F((float)j) * sinus).f()) % cols;
+      uint8_t v = abs8((int8_t)(int)(v1 + F((float)j) * kosinus).f()) % rows;
+      out[j * cols + i] = v * cols + u;
+    }
+  }
+}
+static void rotozoomFixed(float kosinus, float sinus, int cols, int rows, uint8_t *out) {
+  const int32_t kosinusQ = kosinus * 65536, sinusQ = sinus * 65536;
+  for (int i = 0; i < cols; i++) {
+    int32_t u1 = i * kosinusQ;
+    int32_t v1 = i * sinusQ;
+    for (int j = 0; j < rows; j++) {
+      uint8_t u = abs8((u1 - j * sinusQ) / 65536) % cols;
+      uint8_t v = abs8((v1 + j * kosinusQ) / 65536) % rows;
+      out[j * cols + i] = v * cols + u;
+    }
+  }
+}
+struct NativeFloat { // float with the .f() accessor used above
+  float x;
+  NativeFloat(float v = 0) : x(v) {}
+  float f() const { return x; }
+  friend NativeFloat operator*(NativeFloat a, NativeFloat b) { return a.x * b.x; }
+  friend NativeFloat operator+(NativeFloat a, NativeFloat b) { return a.x + b.x; }
+  friend NativeFloat operator-(NativeFloat a, NativeFloat b) { return a.x - b.x; }
+};
+
+template<class Fn> static double usPerFrame(unsigned reps, Fn fn) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < reps; r++) fn(r);
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+}
+
+int main() {
+  // SoftFloat arithmetic against the FPU
+  for (unsigned n = 0; n < 1000000; n++) {
+    float a = (rand() / (float)RAND_MAX - 0.5f) * 40, b = (rand() / (float)RAND_MAX - 0.5f) * 40;
+    float m = (SoftFloat(a) * SoftFloat(b)).f(), s = (SoftFloat(a) + SoftFloat(b)).f();
+    if (fabsf(m - a * b) > fabsf(a * b) * 1e-6f + 1e-30f || fabsf(s - (a + b)) > (fabsf(a) + fabsf(b)) * 1e-6f || (SoftFloat(a) > SoftFloat(b)) != (a > b)) {
+      CHECK(false, "SoftFloat %g %g: %g %g", a, b, m, s);
+      break;
+    }
+  }
+
+  const int cols = 32, rows = 32, maxIterations = 64; // intensity 128
+  std::vector<uint8_t> fl(cols * rows), fx(cols * rows), sf(cols * rows);
+
+  // Julia: iteration counts of the fixed point kernel match the float kernel except near the (chaotic) border of the set
+  unsigned same = 0, close = 0, total = 0;
+  for (uint32_t t = 0; t < 200000; t += 997) {
+    JuliaFrame fr = juliaFrame(t, cols, rows);
+    juliaFloat<float>(fr, cols, rows, maxIterations, fl.data());
+    juliaFixed(fr, cols, rows, maxIterations, fx.data());
+    for (int p = 0; p < cols * rows; p++) { same += fl[p] == fx[p]; close += abs(fl[p] - fx[p]) <= 2; total++; }
+  }
+  CHECK(same * 100 >= total * 95 && close * 1000 >= total * 995, "Julia: %u of %u pixels equal, %u within 2 iterations", same, total, close);
+  printf("Julia %dx%d, %d iterations: fixed point equals float in %.2f%% of pixels, within 2 iterations in %.2f%%\n",
+    cols, rows, maxIterations, same * 100.0 / total, close * 100.0 / total);
+
+  // Rotozoomer: source pixel of the fixed point kernel matches the float kernel except where the float coordinate is within rounding of an integer
+  same = total = 0;
+  for (float a = 0; a > -20; a -= 0.37f) {
+    float f = (sinf(a / 2) + 1.1f + 0.5f) / 1.5f;
+    rotozoomFloat<NativeFloat>(cosf(a) * f, sinf(a) * f, cols, rows, fl.data());
+    rotozoomFixed(cosf(a) * f, sinf(a) * f, cols, rows, fx.data());
+    for (int p = 0; p < cols * rows; p++) { same += fl[p] == fx[p]; total++; }
+  }
+  CHECK(same * 1000 >= total * 995, "Rotozoomer: %u of %u pixels equal", same, total);
+  printf("Rotozoomer %dx%d: fixed point source pixel equals float in %.2f%% of pixels\n", cols, rows, same * 100.0 / total);
+
+  // timings per frame (pixel writes excluded)
+  const unsigned reps = 200;
+  double jf = usPerFrame(reps, [&](unsigned r) { juliaFloat<float>(juliaFrame(r * 50, cols, rows), cols, rows, maxIterations, fl.data()); });
+  double js = usPerFrame(reps, [&](unsigned r) { juliaFloat<SoftFloat>(juliaFrame(r * 50, cols, rows), cols, rows, maxIterations, sf.data()); });
+  double jq = usPerFrame(reps, [&](unsigned r) { juliaFixed(juliaFrame(r * 50, cols, rows), cols, rows, maxIterations, fx.data()); });
+  printf("Julia per frame: float (FPU) %.1f us, float (software) %.1f us, fixed point %.1f us\n", jf, js, jq);
+  double rf = usPerFrame(reps * 10, [&](unsigned r) { rotozoomFloat<NativeFloat>(cosf(r * 0.03f), sinf(r * 0.03f), cols, rows, fl.data()); });
+  double rs = usPerFrame(reps * 10, [&](unsigned r) { rotozoomFloat<SoftFloat>(cosf(r * 0.03f), sinf(r * 0.03f), cols, rows, sf.data()); });
+  double rq = usPerFrame(reps * 10, [&](unsigned r) { rotozoomFixed(cosf(r * 0.03f), sinf(r * 0.03f), cols, rows, fx.data()); });
+  printf("Rotozoomer per frame: float (FPU) %.1f us, float (software) %.1f us, fixed point %.1f us\n", rf, rs, rq);
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Host test and benchmark of the bit sliced Game of Life neighbour count (wled00/fx_life.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/fx_life_test tools/fx_life_test.cpp && /tmp/fx_life_test
+ * compares with a naive per cell count over a toroidal grid, benchmark includes the old one byte per cell engine
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include "../wled00/fx_life.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+// bit planes as laid out by mode_2Dgameoflife()
+struct Grid {
+  int cols, rows;
+  unsigned wordsPerRow, lastWord, lastBit;
+  std::vector<uint32_t> plane;
+  Grid(int c, int r) : cols(c), rows(r), wordsPerRow((c + 31) >> 5), lastWord(wordsPerRow - 1), lastBit((c - 1) & 31), plane(wordsPerRow * r) {}
+  bool get(int x, int y) const { return plane[y * wordsPerRow + (x >> 5)] & (1U << (x & 31)); }
+  void set(int x, int y) { plane[y * wordsPerRow + (x >> 5)] |= 1U << (x & 31); }
+  unsigned naiveCount(int x, int y) const {
+    unsigned n = 0;
+    for (int dy = -1; dy <= 1; dy++) for (int dx = -1; dx <= 1; dx++) if (dx || dy) n += get((x + dx + cols) % cols, (y + dy + rows) % rows);
+    return n;
+  }
+  // one generation (B3/S23) with the bit sliced count, as the effect does without mutation
+  void step(std::vector<uint32_t> &next) const {
+    const uint32_t lastMask = 0xFFFFFFFFU >> (31 - lastBit);
+    next.resize(plane.size());
+    for (int y = 0; y < rows; y++) {
+      const uint32_t *rowN = plane.data() + ((y + rows - 1) % rows) * wordsPerRow;
+      const uint32_t *rowC = plane.data() + y * wordsPerRow;
+      const uint32_t *rowS = plane.data() + ((y + 1) % rows) * wordsPerRow;
+      for (unsigned w = 0; w < wordsPerRow; w++) {
+        uint32_t two, three;
+        lifeNeighbourCount(rowN, rowC, rowS, w, lastWord, lastBit, two, three);
+        next[y * wordsPerRow + w] = (three | (rowC[w] & two)) & (w == lastWord ? lastMask : 0xFFFFFFFFU);
+      }
+    }
+  }
+};
+
+// old engine: one byte per cell, 8 neighbours read per cell with modulo wrapping on edge cells
+static void stepBytes(const uint8_t *cells, uint8_t *next, int cols, int rows) {
+  for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
+    const bool edge = x == 0 || x == cols - 1 || y == 0 || y == rows - 1;
+    unsigned n = 0;
+    for (int i = -1; i <= 1; i++) for (int j = -1; j <= 1; j++) if (i || j) {
+      int nX = x + j, nY = y + i;
+      if (edge) { nX = (nX + cols) % cols; nY = (nY + rows) % rows; }
+      n += cells[nX + nY * cols];
+    }
+    const uint8_t alive = cells[x + y * cols];
+    next[x + y * cols] = n == 3 || (alive && n == 2);
+  }
+}
+
+int main() {
+  const int sizes[] = {1, 2, 3, 5, 31, 32, 33, 63, 64, 65, 100};
+  for (int cols : sizes) for (int rows : {1, 2, 3, 7, 32, 33}) {
+    for (unsigned run = 0; run < 10; run++) {
+      Grid g(cols, rows);
+      const int density = 1 + run % 5; // 1 in density cells alive
+      for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) if (rand() % density == 0) g.set(x, y);
+      // two/three masks match the naive count for every cell
+      bool ok = true;
+      for (int y = 0; y < rows && ok; y++) {
+        const uint32_t *rowN = g.plane.data() + ((y + rows - 1) % rows) * g.wordsPerRow;
+        const uint32_t *rowC = g.plane.data() + y * g.wordsPerRow;
+        const uint32_t *rowS = g.plane.data() + ((y + 1) % rows) * g.wordsPerRow;
+        for (unsigned w = 0; w < g.wordsPerRow && ok; w++) {
+          uint32_t two, three;
+          lifeNeighbourCount(rowN, rowC, rowS, w, g.lastWord, g.lastBit, two, three);
+          for (int bit = 0; bit < 32 && ok; bit++) {
+            const int x = w * 32 + bit;
+            if (x >= cols) break;
+            const unsigned n = g.naiveCount(x, y);
+            if (bool(two & (1U << bit)) != (n == 2) || bool(three & (1U << bit)) != (n == 3)) {
+              CHECK(false, "%dx%d cell %d,%d: naive count %u, two %d three %d", cols, rows, x, y, n, bool(two & (1U << bit)), bool(three & (1U << bit)));
+              ok = false;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // several generations of the bit sliced engine match the old one byte per cell engine
+  for (int cols : {3, 17, 32, 45, 64}) for (int rows : {3, 16, 21}) {
+    Grid g(cols, rows);
+    std::vector<uint8_t> bytes(cols * rows), bytesNext(cols * rows);
+    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) if (rand() % 3 == 0) { g.set(x, y); bytes[x + y * cols] = 1; }
+    std::vector<uint32_t> next;
+    for (int gen = 0; gen < 50; gen++) {
+      g.step(next);
+      g.plane.swap(next);
+      stepBytes(bytes.data(), bytesNext.data(), cols, rows);
+      bytes.swap(bytesNext);
+      bool same = true;
+      for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) same &= g.get(x, y) == bool(bytes[x + y * cols]);
+      if (!same) { CHECK(false, "%dx%d generation %d differs from the byte engine", cols, rows, gen); break; }
+    }
+  }
+
+  // a glider crossing the word boundary and the wrap edge is back in shape after 4 generations, moved by 1,1
+  {
+    Grid g(40, 10);
+    const int glider[5][2] = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    for (auto &p : glider) g.set((p[0] + 30) % 40, (p[1] + 8) % 10);
+    std::vector<uint32_t> next;
+    for (int gen = 0; gen < 4 * 12; gen++) { g.step(next); g.plane.swap(next); }
+    Grid expect(40, 10);
+    for (auto &p : glider) expect.set((p[0] + 42) % 40, (p[1] + 20) % 10);
+    CHECK(g.plane == expect.plane, "glider did not travel across word and wrap edges");
+  }
+
+  // timing per generation, 64x64: neighbour count and rule only (pixel writes, fading and repeat detection excluded)
+  {
+    const int cols = 64, rows = 64;
+    const unsigned reps = 2000;
+    Grid g(cols, rows);
+    std::vector<uint8_t> bytes(cols * rows), bytesNext(cols * rows);
+    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) if (rand() % 3 == 0) { g.set(x, y); bytes[x + y * cols] = 1; }
+    std::vector<uint32_t> next;
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < reps; r++) { g.step(next); g.plane.swap(next); }
+    auto t1 = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < reps; r++) { stepBytes(bytes.data(), bytesNext.data(), cols, rows); bytes.swap(bytesNext); }
+    auto t2 = std::chrono::steady_clock::now();
+    bool same = true;
+    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) same &= g.get(x, y) == bool(bytes[x + y * cols]);
+    CHECK(same, "benchmark grids differ");
+    printf("generation %dx%d: byte per cell %.1f us, bit sliced %.1f us, state %u vs %u bytes\n", cols, rows,
+      std::chrono::duration<double, std::micro>(t2 - t1).count() / reps, std::chrono::duration<double, std::micro>(t1 - t0).count() / reps,
+      cols * rows, 5 * (unsigned)g.plane.size() * 4);
+  }
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
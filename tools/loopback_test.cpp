@@ -0,0 +1,71 @@
+/*
+ * Host test and benchmark for loopback bus frame capture (wled00/loopback.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/loopback_test tools/loopback_test.cpp && /tmp/loopback_test [capture.rgb]
+ * with a file name the captured frames (oldest first, raw RGB bytes) are written to it for diffing rendered output
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include "../wled00/loopback.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+int main(int argc, char **argv) {
+  // wire time: 300 RGB WS2812 = 300*24*1.25us + 300us; 16 bit doubles bits, 400kHz doubles bit time
+  CHECK(loopbackWireTime(300, 3, false, false) == 9300, "WS2812 300 LEDs %u us", loopbackWireTime(300, 3, false, false));
+  CHECK(loopbackWireTime(300, 4, true, false) == 24300, "UCS8904 300 LEDs %u us", loopbackWireTime(300, 4, true, false));
+  CHECK(loopbackWireTime(10, 3, false, true) == 900, "WS2811 400kHz 10 LEDs %u us", loopbackWireTime(10, 3, false, true));
+
+  // ring buffer: frame n is retrievable until maxFrames newer frames were shown, brightness is applied
+  const size_t len = 16, ch = 3, frameSize = len * ch;
+  const unsigned maxFrames = 4;
+  std::vector<uint8_t> data(frameSize * (maxFrames + 1));
+  uint32_t frameCount = 0;
+  CHECK(loopbackFrame(data.data(), frameSize, maxFrames, frameCount, 0) == nullptr, "frame before first show");
+  for (unsigned f = 0; f < 10; f++) {
+    for (size_t i = 0; i < frameSize; i++) data[i] = f * 10 + i;
+    loopbackCapture(data.data(), frameSize, maxFrames, frameCount++, f & 1 ? 127 : 255);
+  }
+  for (unsigned n = 0; n < maxFrames; n++) {
+    const uint8_t *fr = loopbackFrame(data.data(), frameSize, maxFrames, frameCount, n);
+    unsigned f = 9 - n;
+    CHECK(fr != nullptr, "frame %u missing", n);
+    if (fr) for (size_t i = 0; i < frameSize; i++) {
+      unsigned v = (f * 10 + i) & 0xFF;
+      unsigned expect = f & 1 ? (v * 128) >> 8 : v;
+      if (fr[i] != expect) { CHECK(false, "frame %u byte %u: %u != %u", n, (unsigned)i, fr[i], expect); break; }
+    }
+  }
+  CHECK(loopbackFrame(data.data(), frameSize, maxFrames, frameCount, maxFrames) == nullptr, "frame beyond ring");
+  CHECK(loopbackFrame(data.data(), frameSize, 0, frameCount, 0) == nullptr, "frame without capture");
+
+  // throughput at 10k LEDs: capture cost per shown frame vs wire time of the emulated strip
+  const size_t bigLen = 10000, bigSize = bigLen * ch;
+  const unsigned bigFrames = 8, reps = 2000;
+  std::vector<uint8_t> big(bigSize * (bigFrames + 1));
+  for (size_t i = 0; i < bigSize; i++) big[i] = rand();
+  double ns[2];
+  for (unsigned b = 0; b < 2; b++) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < reps; r++) loopbackCapture(big.data(), bigSize, bigFrames, r, b ? 200 : 255);
+    ns[b] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / reps;
+  }
+  printf("10k RGB LEDs capture: %.1f us/frame (full brightness), %.1f us/frame (scaled); emulated WS2812 wire time %u us\n",
+    ns[0] / 1000, ns[1] / 1000, loopbackWireTime(bigLen, 3, false, false));
+
+  if (argc > 1) {
+    FILE *f = fopen(argv[1], "wb");
+    CHECK(f != nullptr, "cannot open %s", argv[1]);
+    if (f) {
+      for (int n = maxFrames - 1; n >= 0; n--) fwrite(loopbackFrame(data.data(), frameSize, maxFrames, frameCount, n), 1, frameSize, f);
+      fclose(f);
+      printf("wrote %u frames of %u LEDs to %s\n", maxFrames, (unsigned)len, argv[1]);
+    }
+  }
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
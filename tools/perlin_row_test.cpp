@@ -0,0 +1,125 @@
+/*
+ * Host test and benchmark of the batch (row) Perlin noise functions against the single sample ones (wled00/perlin.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/perlin_row_test tools/perlin_row_test.cpp && /tmp/perlin_row_test
+ * the wrappers below mirror perlin16()/perlin8() and perlin16Row()/perlin8Row() in util.cpp
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include "../wled00/perlin.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+static uint16_t perlin16(uint32_t x, uint32_t y)             { return ((perlin2DNoise(x, y, false) * 1537) >> 10) + 32725; }
+static uint16_t perlin16(uint32_t x, uint32_t y, uint32_t z) { return ((perlin3DNoise(x, y, z, false) * 1731) >> 10) + 33147; }
+static uint8_t perlin8(uint16_t x, uint16_t y)               { return (((perlin2DNoise((uint32_t)x << 8, (uint32_t)y << 8, true) * 1620) >> 10) + 32771) >> 8; }
+static uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z)   { return (((perlin3DNoise((uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8, true) * 2015) >> 10) + 33168) >> 8; }
+
+static void perlin16Row(uint16_t *out, unsigned count, uint32_t x, uint32_t dx, uint32_t y) {
+  uint32_t xi = x - dx;
+  perlin2DRow_raw(count, [&]() { return xi += dx; }, y, false,
+                  [&](unsigned i, int32_t n) { out[i] = ((n * 1537) >> 10) + 32725; });
+}
+static void perlin16Row(uint16_t *out, unsigned count, uint32_t x, uint32_t dx, uint32_t y, uint32_t z) {
+  uint32_t xi = x - dx;
+  perlin3DRow_raw(count, [&]() { return xi += dx; }, y, z, false,
+                  [&](unsigned i, int32_t n) { out[i] = ((n * 1731) >> 10) + 33147; });
+}
+static void perlin8Row(uint8_t *out, unsigned count, uint16_t x, uint16_t dx, uint16_t y) {
+  uint16_t xi = x - dx;
+  perlin2DRow_raw(count, [&]() { xi += dx; return (uint32_t)xi << 8; }, (uint32_t)y << 8, true,
+                  [&](unsigned i, int32_t n) { out[i] = (((n * 1620) >> 10) + 32771) >> 8; });
+}
+static void perlin8Row(uint8_t *out, unsigned count, uint16_t x, uint16_t dx, uint16_t y, uint16_t z) {
+  uint16_t xi = x - dx;
+  perlin3DRow_raw(count, [&]() { xi += dx; return (uint32_t)xi << 8; }, (uint32_t)y << 8, (uint32_t)z << 8, true,
+                  [&](unsigned i, int32_t n) { out[i] = (((n * 2015) >> 10) + 33168) >> 8; });
+}
+
+static uint32_t rand32() { return (uint32_t)rand() << 16 ^ (uint32_t)rand(); }
+
+// step sizes used by the effects (sub-cell, about a cell, several cells) plus random and negative ones
+static uint32_t randomStep(unsigned run, bool is8bit) {
+  switch (run % 6) {
+    case 0:  return 1 + rand() % 64;
+    case 1:  return is8bit ? 40 : 1000;
+    case 2:  return is8bit ? 200 + rand() % 100 : 0x10000 + rand() % 0x8000;
+    case 3:  return is8bit ? rand() % 0x10000 : rand32();
+    case 4:  return is8bit ? 0x10000 - 1 - rand() % 300 : 0 - 1 - rand() % 70000; // negative (wraps backwards)
+    default: return 0;
+  }
+}
+
+template<class Fn> static double nsPerSample(unsigned samples, Fn fn) {
+  double best = 1e30;
+  for (unsigned run = 0; run < 5; run++) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / samples;
+    if (ns < best) best = ns;
+  }
+  return best;
+}
+
+int main() {
+  // row functions return exactly the single sample values, including coordinate wrap (start near the end of the range)
+  const unsigned rows = 20000;
+  unsigned long samples = 0, mismatches = 0;
+  std::vector<uint16_t> r16(300);
+  std::vector<uint8_t> r8(300);
+  for (unsigned run = 0; run < rows; run++) {
+    const unsigned count = 1 + rand() % 300;
+    const bool nearEnd = run % 4 == 0;
+    const uint32_t x = nearEnd ? 0 - rand() % 0x40000 : rand32(), y = rand32(), z = rand32(), dx = randomStep(run, false);
+    const uint16_t x8 = nearEnd ? 0x10000 - rand() % 2000 : rand(), y8 = rand(), z8 = rand(), dx8 = randomStep(run, true);
+    perlin16Row(r16.data(), count, x, dx, y);
+    for (unsigned i = 0; i < count; i++) mismatches += r16[i] != perlin16(x + i * dx, y);
+    perlin16Row(r16.data(), count, x, dx, y, z);
+    for (unsigned i = 0; i < count; i++) mismatches += r16[i] != perlin16(x + i * dx, y, z);
+    perlin8Row(r8.data(), count, x8, dx8, y8);
+    for (unsigned i = 0; i < count; i++) mismatches += r8[i] != perlin8(uint16_t(x8 + i * dx8), y8);
+    perlin8Row(r8.data(), count, x8, dx8, y8, z8);
+    for (unsigned i = 0; i < count; i++) mismatches += r8[i] != perlin8(uint16_t(x8 + i * dx8), y8, z8);
+    samples += 4 * count;
+  }
+  CHECK(mismatches == 0, "%lu of %lu samples differ from the single sample functions", mismatches, samples);
+  printf("%u random rows: %lu samples, %lu mismatches\n", rows, samples, mismatches);
+
+  // throughput per sample, 64 samples per row like a 64 wide matrix
+  const unsigned count = 64, reps = 20000;
+  volatile uint32_t sink = 0;
+  for (uint16_t dx8 : {8, 40, 255}) {
+    double single = nsPerSample(count * reps, [&]() {
+      uint32_t s = 0;
+      for (unsigned r = 0; r < reps; r++) for (unsigned i = 0; i < count; i++) s += perlin8(uint16_t(i * dx8), uint16_t(r * 40), 1234);
+      sink = s;
+    });
+    double row = nsPerSample(count * reps, [&]() {
+      uint32_t s = 0;
+      for (unsigned r = 0; r < reps; r++) { perlin8Row(r8.data(), count, 0, dx8, uint16_t(r * 40), 1234); s += r8[r % count]; }
+      sink = s;
+    });
+    printf("perlin8 3D, step %u: single %.1f ns, row %.1f ns per sample\n", dx8, single, row);
+  }
+  for (uint32_t dx : {1000U, 0x10000U}) {
+    double single = nsPerSample(count * reps, [&]() {
+      uint32_t s = 0;
+      for (unsigned r = 0; r < reps; r++) for (unsigned i = 0; i < count; i++) s += perlin16(i * dx, r * 1000);
+      sink = s;
+    });
+    double row = nsPerSample(count * reps, [&]() {
+      uint32_t s = 0;
+      for (unsigned r = 0; r < reps; r++) { perlin16Row(r16.data(), count, 0, dx, r * 1000); s += r16[r % count]; }
+      sink = s;
+    });
+    printf("perlin16 2D, step %u: single %.1f ns, row %.1f ns per sample\n", dx, single, row);
+  }
+  (void)sink;
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * Host comparison and benchmark of the blur kernels (wled00/pixel_blur.h) with the previous Segment::blur()/blur2D() loops
+ * build & run: g++ -O2 -std=c++17 -o /tmp/pixel_blur_test tools/pixel_blur_test.cpp && /tmp/pixel_blur_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include "../wled00/pixel_blur.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+// previous kernels: color_add() without ratio preservation (colors.cpp) and the blur loops reading back the previous pixel
+static uint32_t color_add(uint32_t c1, uint32_t c2) {
+  if (c1 == 0) return c2;
+  if (c2 == 0) return c1;
+  uint32_t rb = ( c1     & 0x00FF00FF) + ( c2     & 0x00FF00FF);
+  uint32_t wg = ((c1>>8) & 0x00FF00FF) + ((c2>>8) & 0x00FF00FF);
+  rb |= ((rb & 0x01000100) - ((rb >> 8) & 0x00010001)) & 0x00FF00FF;
+  wg |= ((wg & 0x01000100) - ((wg >> 8) & 0x00010001)) & 0x00FF00FF;
+  return rb | (wg << 8);
+}
+static void oldBlurLine(uint32_t *pxls, unsigned length, unsigned stride, uint8_t keep, uint8_t seep) {
+  uint32_t cur = pxls[0];
+  uint32_t carryover = fast_color_scale(cur, seep);
+  pxls[0] = fast_color_scale(cur, keep);
+  for (unsigned i = 1; i < length; i++) {
+    cur = pxls[i * stride];
+    uint32_t part = fast_color_scale(cur, seep);
+    cur = fast_color_scale(cur, keep);
+    cur = color_add(cur, carryover);
+    pxls[(i - 1) * stride] = color_add(pxls[(i - 1) * stride], part);
+    pxls[i * stride] = cur;
+    carryover = part;
+  }
+}
+static void oldBlur2D(uint32_t *pxls, unsigned cols, unsigned rows, uint8_t blur_x, uint8_t blur_y, bool smear) {
+  if (blur_x) for (unsigned y = 0; y < rows; y++) oldBlurLine(pxls + y * cols, cols, 1, smear ? 255 : 255 - blur_x, blur_x >> 1);
+  if (blur_y) for (unsigned x = 0; x < cols; x++) oldBlurLine(pxls + x, rows, cols, smear ? 255 : 255 - blur_y, blur_y >> 1);
+}
+static void newBlur2D(uint32_t *pxls, unsigned cols, unsigned rows, uint8_t blur_x, uint8_t blur_y, bool smear, uint32_t *carryover) {
+  if (blur_x) for (unsigned y = 0; y < rows; y++) blurPixelLine(pxls + y * cols, cols, smear ? 255 : 255 - blur_x, blur_x >> 1);
+  if (blur_y) blurPixelColumns(pxls, cols, rows, smear ? 255 : 255 - blur_y, blur_y >> 1, carryover);
+}
+
+// per channel reference: keep of the pixel plus seep of both neighbours, saturated
+static void refBlurLine(uint32_t *pxls, unsigned length, unsigned stride, uint8_t keep, uint8_t seep) {
+  std::vector<uint32_t> src(length);
+  for (unsigned i = 0; i < length; i++) src[i] = pxls[i * stride];
+  for (unsigned i = 0; i < length; i++) {
+    uint32_t c = 0;
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+      unsigned v = (((src[i] >> shift) & 0xFF) * keep) >> 8;
+      if (i > 0)          v += (((src[i - 1] >> shift) & 0xFF) * seep) >> 8;
+      if (i + 1 < length) v += (((src[i + 1] >> shift) & 0xFF) * seep) >> 8;
+      c |= (v > 255 ? 255 : v) << shift;
+    }
+    pxls[i * stride] = c;
+  }
+}
+
+// per channel reference of the separable box blur: truncated average over the window clipped at the edges
+static void refBoxLine(uint32_t *pxls, unsigned length, unsigned stride, unsigned radius, bool smear) {
+  std::vector<uint32_t> src(length);
+  for (unsigned i = 0; i < length; i++) src[i] = pxls[i * stride];
+  for (int i = 0; i < (int)length; i++) {
+    uint32_t c = 0;
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+      unsigned sum = 0, n = 0;
+      for (int j = i - (int)radius; j <= i + (int)radius; j++) if (j >= 0 && j < (int)length) { sum += (src[j] >> shift) & 0xFF; n++; }
+      unsigned v = sum / n, o = (src[i] >> shift) & 0xFF;
+      if (smear && o > v) v = o;
+      c |= v << shift;
+    }
+    pxls[i * stride] = c;
+  }
+}
+
+static uint32_t randomColor(unsigned run) {
+  uint32_t c = (uint32_t)rand() << 16 ^ rand();
+  if (run % 3 == 0) c |= 0xC0C0C0C0; // bright pixels to force saturation
+  if (run % 5 == 0 && rand() % 2) c = 0;
+  return c;
+}
+
+// best of 5 runs (host timings are noisy)
+template<class Fn> static double usPer(unsigned reps, Fn fn) {
+  double best = 1e30;
+  for (unsigned run = 0; run < 5; run++) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < reps; r++) fn();
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+    if (us < best) best = us;
+  }
+  return best;
+}
+
+int main() {
+  // fast_color_add() saturates each channel of the sum of three colors
+  for (unsigned n = 0; n < 1000000; n++) {
+    uint32_t a = randomColor(n), b = randomColor(n + 1), c = n & 1 ? randomColor(n + 2) : 0, expect = 0;
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+      unsigned v = ((a >> shift) & 0xFF) + ((b >> shift) & 0xFF) + ((c >> shift) & 0xFF);
+      expect |= (v > 255 ? 255 : v) << shift;
+    }
+    if (fast_color_add(a, b, c) != expect) { CHECK(false, "fast_color_add(%08X, %08X, %08X) = %08X", a, b, c, fast_color_add(a, b, c)); break; }
+  }
+
+  // 1D and 2D blur: identical to the previous loops without smear, identical to the per channel reference always
+  // (with smear the previous color_add() left overflow bits of red/blue in the white/green LSB)
+  unsigned smearDiffs = 0, smearPixels = 0;
+  for (unsigned run = 0; run < 3000; run++) {
+    const unsigned cols = 1 + rand() % 70, rows = 1 + rand() % 40;
+    const uint8_t bx = rand() % 4 ? rand() : 0, by = rand() % 4 ? rand() : 0;
+    const bool smear = run % 2;
+    std::vector<uint32_t> src(cols * rows), a, b, r, carry(cols);
+    for (auto &c : src) c = randomColor(run);
+    a = b = r = src;
+    oldBlur2D(a.data(), cols, rows, bx, by, smear);
+    newBlur2D(b.data(), cols, rows, bx, by, smear, carry.data());
+    if (bx) for (unsigned y = 0; y < rows; y++) refBlurLine(r.data() + y * cols, cols, 1, smear ? 255 : 255 - bx, bx >> 1);
+    if (by) for (unsigned x = 0; x < cols; x++) refBlurLine(r.data() + x, rows, cols, smear ? 255 : 255 - by, by >> 1);
+    if (b != r) { CHECK(false, "run %u %ux%u blur %u/%u smear %d differs from reference", run, cols, rows, bx, by, smear); break; }
+    if (!smear && a != b) { CHECK(false, "run %u %ux%u blur %u/%u differs from previous kernel", run, cols, rows, bx, by); break; }
+    if (smear) { for (size_t i = 0; i < a.size(); i++) smearDiffs += a[i] != b[i]; smearPixels += a.size(); }
+  }
+  printf("blur with smear: %.2f%% of pixels differ from the previous kernel (its overflow bug), 0 from the reference\n", smearDiffs * 100.0 / smearPixels);
+
+  // box blur against the per channel reference (rows, then columns)
+  for (unsigned run = 0; run < 3000; run++) {
+    const unsigned cols = 1 + rand() % 70, rows = 1 + rand() % 40, radius = 1 + rand() % 3;
+    const bool smear = run % 2;
+    std::vector<uint32_t> b(cols * rows), r, line(cols > rows ? cols : rows);
+    for (auto &c : b) c = randomColor(run);
+    r = b;
+    for (unsigned y = 0; y < rows; y++) boxBlurPixelLine(b.data() + y * cols, cols, 1, radius, smear, line.data());
+    for (unsigned x = 0; x < cols; x++) boxBlurPixelLine(b.data() + x, rows, cols, radius, smear, line.data());
+    for (unsigned y = 0; y < rows; y++) refBoxLine(r.data() + y * cols, cols, 1, radius, smear);
+    for (unsigned x = 0; x < cols; x++) refBoxLine(r.data() + x, rows, cols, radius, smear);
+    if (b != r) { CHECK(false, "run %u %ux%u box blur radius %u smear %d differs from reference", run, cols, rows, radius, smear); break; }
+  }
+
+  // timings of a full 2D blur (blur2D(128, 128)) and a box blur, each on fresh random content (repeated blurring fades to black)
+  for (unsigned size : {32, 128}) {
+    const unsigned cols = size, rows = size == 32 ? 32 : 64, reps = size == 32 ? 20000 : 2000;
+    std::vector<uint32_t> src(cols * rows), a(cols * rows), line(cols), carry(cols);
+    for (auto &c : src) c = randomColor(1);
+    double tCopy = usPer(reps, [&]() { memcpy(a.data(), src.data(), src.size() * 4); a[rand() % a.size()] ^= 1; });
+    double tOld = usPer(reps, [&]() { memcpy(a.data(), src.data(), src.size() * 4); oldBlur2D(a.data(), cols, rows, 128, 128, false); }) - tCopy;
+    double tNew = usPer(reps, [&]() { memcpy(a.data(), src.data(), src.size() * 4); newBlur2D(a.data(), cols, rows, 128, 128, false, carry.data()); }) - tCopy;
+    double tBox = usPer(reps, [&]() {
+      memcpy(a.data(), src.data(), src.size() * 4);
+      for (unsigned y = 0; y < rows; y++) boxBlurPixelLine(a.data() + y * cols, cols, 1, 1, false, line.data());
+      for (unsigned x = 0; x < cols; x++) boxBlurPixelLine(a.data() + x, rows, cols, 1, false, line.data());
+    }) - tCopy;
+    printf("%ux%u: blur2D previous %.1f us, current %.1f us, box_blur(1) %.1f us\n", cols, rows, tOld, tNew, tBox);
+  }
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * Host test and apply-time benchmark for the preset read cache (wled00/presets.cpp)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/preset_cache_test tools/preset_cache_test.cpp && /tmp/preset_cache_test
+ * compares parsing the cached (minified) JSON with copying a pre-parsed JsonDocument (the alternative "compiled" form)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "../wled00/src/dependencies/json/ArduinoJson-v6.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+// typical two segment preset as written by doSaveState() (pretty printed like presets.json may be after /edit)
+static const char *presetFile =
+  "{\"on\":true, \"bri\":128, \"transition\":7, \"mainseg\":0,\n"
+  " \"seg\":[{\"id\":0,\"start\":0,\"stop\":300,\"grp\":1,\"spc\":0,\"of\":0,\"on\":true,\"frz\":false,\"bri\":255,\"cct\":127,\"set\":0,"
+  "\"n\":\"Main \\\"left\\\"\",\"col\":[[255,160,0],[0,0,0],[0,0,0]],\"fx\":65,\"sx\":128,\"ix\":128,\"pal\":11,\"c1\":128,\"c2\":128,\"c3\":16,"
+  "\"sel\":true,\"rev\":false,\"mi\":false,\"o1\":false,\"o2\":false,\"o3\":false,\"si\":0,\"m12\":0},"
+  "{\"id\":1,\"start\":300,\"stop\":600,\"grp\":1,\"spc\":0,\"of\":0,\"on\":true,\"frz\":false,\"bri\":255,\"cct\":127,\"set\":0,"
+  "\"col\":[[0,0,255],[0,0,0],[0,0,0]],\"fx\":9,\"sx\":128,\"ix\":128,\"pal\":0,\"c1\":128,\"c2\":128,\"c3\":16,"
+  "\"sel\":false,\"rev\":false,\"mi\":false,\"o1\":false,\"o2\":false,\"o3\":false,\"si\":0,\"m12\":0},{\"stop\":0},{\"stop\":0}],"
+  " \"n\":\"Evening\", \"ql\":\"E\"}";
+
+template<class F> static double usPer(unsigned n, F f) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; i++) f();
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / n;
+}
+
+int main() {
+  DynamicJsonDocument doc(8192);
+  CHECK(!deserializeJson(doc, presetFile), "preset does not parse");
+
+  // cachePreset(): minified JSON in a buffer of measureJson() + 1 bytes
+  size_t len = measureJson(doc) + 1;
+  char *cached = (char*)malloc(len);
+  CHECK(serializeJson(doc, cached, len) == len - 1, "cached JSON truncated");
+
+  // handlePresets(): parsing the cached JSON yields the same state as parsing the file
+  DynamicJsonDocument fromCache(8192);
+  CHECK(!deserializeJson(fromCache, (const char*)cached), "cached preset does not parse");
+  CHECK(fromCache == doc, "cached preset differs from file");
+
+  // strings must be copied (const char* input): staged/cached buffer may be freed while the state is applied
+  memset(cached, ' ', len - 1);
+  CHECK(strcmp(fromCache["seg"][0]["n"] | "", "Main \"left\"") == 0 && strcmp(fromCache["n"] | "", "Evening") == 0, "strings reference cache buffer");
+  CHECK(serializeJson(doc, cached, len) == len - 1, "cached JSON rewrite");
+
+  // apply-time cost of the JSON stage (deserializeState() itself is the same for all variants)
+  const unsigned reps = 100000;
+  DynamicJsonDocument compiled(4096);
+  compiled.set(doc);
+  double parseFile   = usPer(reps, [&]() { deserializeJson(fromCache, presetFile); });
+  double parseCached = usPer(reps, [&]() { deserializeJson(fromCache, (const char*)cached); });
+  double copyDoc     = usPer(reps, [&]() { fromCache.set(compiled); });
+  CHECK(fromCache == doc, "copied preset differs");
+  printf("JSON stage per apply: parse file text %.2f us, parse cached JSON %.2f us, copy pre-parsed document %.2f us\n", parseFile, parseCached, copyDoc);
+  printf("RAM per cached preset: JSON %u bytes, pre-parsed document %u bytes\n", (unsigned)len, (unsigned)compiled.memoryUsage());
+
+  free(cached);
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * Host test for the presets.json index scanner (wled00/preset_index.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/preset_index_test tools/preset_index_test.cpp && /tmp/preset_index_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../wled00/preset_index.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+// builds a file obeying the structural requirements in file.cpp: root level "id":{...} objects separated by ',' with
+// runs of spaces (holes of deleted/replaced presets) before the separator; values contain nested numeric keys and escapes
+static std::string makeFile(uint32_t *expect, size_t &holeBytes, unsigned &holes) {
+  std::string s = "{\"0\":{}";
+  expect[0] = 5;
+  holeBytes = 0; holes = 0;
+  for (int id = 1; id < PRESET_INDEX_SIZE; id++) {
+    if (rand() % 3 == 0) continue; // unused slot
+    if (rand() % 4 == 0) {
+      unsigned n = 1 + rand() % 300;
+      s.append(n, ' ');
+      holeBytes += n; holes++;
+    }
+    s += ",\"" + std::to_string(id) + "\":";
+    expect[id] = s.size();
+    s += "{\"n\":\"name \\\"" + std::to_string(id) + "\\\": {x}\",\"seg\":[{\"id\":0,\"col\":[[255,0,0]]}],\"" + std::to_string(rand() % 250) + "\":{\"on\":true}}";
+  }
+  s += "}";
+  return s;
+}
+
+int main() {
+  for (unsigned run = 0; run < 200; run++) {
+    uint32_t expect[PRESET_INDEX_SIZE] = {0}, index[PRESET_INDEX_SIZE] = {0};
+    size_t holeBytes; unsigned holes;
+    std::string file = makeFile(expect, holeBytes, holes);
+    // feed in random chunk sizes to exercise state carried between buffers
+    PresetIndexScan scan;
+    size_t scannedBytes = 0; unsigned scannedHoles = 0;
+    size_t p = 0;
+    while (p < file.size()) {
+      size_t n = 1 + rand() % 256;
+      if (n > file.size() - p) n = file.size() - p;
+      presetIndexScan(scan, (const uint8_t*)file.data() + p, n, index, [&](size_t pos, size_t len) {
+        scannedBytes += len; scannedHoles++;
+        for (size_t i = 0; i < len; i++) if (file[pos + i] != ' ') { CHECK(false, "hole at %u is not free", (unsigned)pos); break; }
+      });
+      p += n;
+    }
+    for (unsigned id = 0; id < PRESET_INDEX_SIZE; id++) {
+      if (index[id] != expect[id]) { CHECK(false, "run %u id %u at %u expected %u", run, id, index[id], expect[id]); break; }
+      if (index[id]) CHECK(file[index[id]] == '{', "run %u id %u not at '{'", run, id);
+    }
+    CHECK(scannedBytes == holeBytes && scannedHoles == holes, "run %u holes %u/%u bytes %u/%u", run, scannedHoles, holes, (unsigned)scannedBytes, (unsigned)holeBytes);
+  }
+
+  // a same-size rewrite moves objects: an index keyed on file size alone would be stale, rescanning finds new offsets
+  uint32_t a[PRESET_INDEX_SIZE] = {0}, b[PRESET_INDEX_SIZE] = {0};
+  std::string f1 = "{\"0\":{},\"1\":{\"on\":true},   \"2\":{\"on\":false}}";
+  std::string f2 = "{\"0\":{},   \"1\":{\"on\":true},\"2\":{\"on\":false}}";
+  CHECK(f1.size() == f2.size(), "test files differ in size");
+  PresetIndexScan s1, s2;
+  presetIndexScan(s1, (const uint8_t*)f1.data(), f1.size(), a, [](size_t, size_t) {});
+  presetIndexScan(s2, (const uint8_t*)f2.data(), f2.size(), b, [](size_t, size_t) {});
+  CHECK(a[1] != b[1] && f2[b[1]] == '{' && f2[b[2]] == '{', "same size rewrite offsets %u %u", a[1], b[1]);
+
+  // scan speed (index build cost on first preset access)
+  uint32_t index[PRESET_INDEX_SIZE];
+  size_t hb; unsigned h;
+  std::string big = makeFile(index, hb, h);
+  const unsigned reps = 200;
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < reps; r++) {
+    PresetIndexScan scan;
+    presetIndexScan(scan, (const uint8_t*)big.data(), big.size(), index, [](size_t, size_t) {});
+  }
+  double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+  printf("index scan: %.1f us for %u bytes (%.2f ns/byte)\n", us, (unsigned)big.size(), us * 1000 / big.size());
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * Host test and benchmark for the particle system color cache (wled00/ps_colorcache.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/ps_colorcache_test tools/ps_colorcache_test.cpp && /tmp/ps_colorcache_test
+ * palette lookup is a 16 entry gradient with linear blending (like ColorFromPaletteWLED()), desaturation uses copies of
+ * rgb2hsv()/hsv2rgb() from colors.cpp
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include "../wled00/ps_colorcache.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+static uint32_t palette[16];
+static unsigned lookups = 0;
+
+static uint32_t paletteColor(uint8_t index) {
+  lookups++;
+  const uint32_t a = palette[index >> 4], b = palette[((index >> 4) + 1) & 15], f = (index & 15) << 4;
+  uint32_t c = 0;
+  for (int s = 0; s < 24; s += 8) c |= ((((a >> s) & 0xFF) * (256 - f) + ((b >> s) & 0xFF) * f) >> 8) << s;
+  return c;
+}
+
+struct HSV { uint16_t h; uint8_t s, v; };
+static void hsv2rgb(const HSV &hsv, uint32_t &rgb) {
+  unsigned int remainder, region, p, q, t, h = hsv.h, s = hsv.s, v = hsv.v;
+  if (s == 0) { rgb = v << 16 | v << 8 | v; return; }
+  region = h / 10923;
+  remainder = (h - (region * 10923)) * 6;
+  p = (v * (255 - s)) >> 8;
+  q = (v * (255 - ((s * remainder) >> 16))) >> 8;
+  t = (v * (255 - ((s * (65535 - remainder)) >> 16))) >> 8;
+  switch (region) {
+    case 0: rgb = v << 16 | t << 8 | p; break;
+    case 1: rgb = q << 16 | v << 8 | p; break;
+    case 2: rgb = p << 16 | v << 8 | t; break;
+    case 3: rgb = p << 16 | q << 8 | v; break;
+    case 4: rgb = t << 16 | p << 8 | v; break;
+    default: rgb = v << 16 | p << 8 | q; break;
+  }
+}
+static void rgb2hsv(const uint32_t rgb, HSV &hsv) {
+  hsv = {0, 0, 0};
+  int32_t r = (rgb >> 16) & 0xFF, g = (rgb >> 8) & 0xFF, b = rgb & 0xFF;
+  int32_t minval = r < g ? r : g; minval = minval < b ? minval : b;
+  int32_t maxval = r > g ? r : g; maxval = maxval > b ? maxval : b;
+  if (maxval == 0) return;
+  hsv.v = maxval;
+  int32_t delta = maxval - minval;
+  hsv.s = (255 * delta) / maxval;
+  if (hsv.s == 0) return;
+  if (maxval == r) hsv.h = (10923 * (g - b)) / delta;
+  else if (maxval == g) hsv.h = 21845 + (10923 * (b - r)) / delta;
+  else hsv.h = 43690 + (10923 * (r - g)) / delta;
+}
+static unsigned desaturations = 0;
+static uint32_t desaturateColor(uint32_t color, uint8_t sat) {
+  desaturations++;
+  HSV hsv;
+  rgb2hsv(color, hsv);
+  if (sat < hsv.s) hsv.s = sat;
+  hsv2rgb(hsv, color);
+  return color;
+}
+
+static void newPalette() { for (auto &c : palette) c = rand() & 0xFFFFFF; }
+
+int main() {
+  PScolorCache *cache = (PScolorCache *)malloc(sizeof(PScolorCache));
+  // cached colors equal uncached ones, palette changes are picked up after a reset, each index is looked up once per frame
+  for (unsigned frame = 0; frame < 500; frame++) {
+    newPalette();
+    psResetColorCache(cache);
+    lookups = 0;
+    bool seen[256] = {false};
+    unsigned distinct = 0;
+    for (unsigned n = 0; n < 2000; n++) {
+      uint8_t index = frame & 1 ? rand() : 40 + rand() % 16; // spread out / clustered (single emitter)
+      uint8_t sat = rand() % 3 ? 255 : (frame & 2 ? rand() : 100 + (rand() & 3));
+      if (!seen[index]) { seen[index] = true; distinct++; }
+      uint32_t cached = sat < 255 ? psCachedSaturatedColor(cache, index, sat, paletteColor, desaturateColor) : psCachedPaletteColor(cache, index, paletteColor);
+      unsigned l = lookups;
+      uint32_t expect = sat < 255 ? desaturateColor(paletteColor(index), sat) : paletteColor(index);
+      lookups = l;
+      if (cached != expect) { CHECK(false, "frame %u index %u sat %u: %06x != %06x", frame, index, sat, cached, expect); break; }
+    }
+    CHECK(lookups == distinct, "frame %u: %u palette lookups for %u indices", frame, lookups, distinct);
+  }
+  // without cache memory colors are calculated every time
+  CHECK(psCachedSaturatedColor(nullptr, 7, 50, paletteColor, desaturateColor) == desaturateColor(paletteColor(7), 50), "uncached saturated color");
+
+  // benchmark: a frame of 1000 particles from 4 emitters (hue spread of 8, two with reduced saturation)
+  std::vector<uint8_t> hue(1000), sat(1000);
+  for (size_t i = 0; i < hue.size(); i++) {
+    unsigned e = i & 3;
+    hue[i] = e * 64 + rand() % 8;
+    sat[i] = e < 2 ? 255 : 120 + e;
+  }
+  newPalette();
+  const unsigned reps = 2000;
+  volatile uint32_t sink = 0;
+  lookups = desaturations = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < reps; r++)
+    for (size_t i = 0; i < hue.size(); i++) sink += sat[i] < 255 ? desaturateColor(paletteColor(hue[i]), sat[i]) : paletteColor(hue[i]);
+  auto t1 = std::chrono::steady_clock::now();
+  unsigned l0 = lookups / reps, d0 = desaturations / reps;
+  lookups = desaturations = 0;
+  for (unsigned r = 0; r < reps; r++) {
+    psResetColorCache(cache);
+    for (size_t i = 0; i < hue.size(); i++)
+      sink += sat[i] < 255 ? psCachedSaturatedColor(cache, hue[i], sat[i], paletteColor, desaturateColor) : psCachedPaletteColor(cache, hue[i], paletteColor);
+  }
+  auto t2 = std::chrono::steady_clock::now();
+  printf("1000 particles/frame: uncached %.1f ns/particle (%u lookups, %u desaturations), cached %.1f ns/particle (%u lookups, %u desaturations)\n",
+    std::chrono::duration<double, std::nano>(t1 - t0).count() / reps / hue.size(), l0, d0,
+    std::chrono::duration<double, std::nano>(t2 - t1).count() / reps / hue.size(), lookups / reps, desaturations / reps);
+
+  free(cache);
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Host test and benchmark for the 2D particle system collision grid (wled00/ps_grid.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/ps_grid_test tools/ps_grid_test.cpp && /tmp/ps_grid_test
+ * compares the pairs found by the grid with a brute-force check of all pairs, grid set up like ParticleSystem2D::handleCollisions()
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <set>
+#include <utility>
+#include <vector>
+#include "../wled00/ps_grid.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+#define PS_P_RADIUS_SHIFT 6
+#define PS_P_MINHARDRADIUS 64
+
+typedef struct { int16_t x, y; int8_t vx, vy; bool alive, collide; uint8_t size; } Particle;
+typedef std::set<std::pair<uint32_t, uint32_t>> Pairs;
+
+static int32_t clamp(int32_t v, int32_t lo, int32_t hi) { return v < lo ? lo : v > hi ? hi : v; }
+
+// collision distance of two particles (as in handleCollisions())
+static uint32_t collDist(const Particle &a, const Particle &b, uint32_t baseDist, bool adv) {
+  return adv ? baseDist + ((a.size + b.size) >> 1) : baseDist;
+}
+
+static bool close(const Particle &a, const Particle &b, uint32_t dist) {
+  int32_t dx = (b.x + b.vx) - (a.x + a.vx), dy = (b.y + b.vy) - (a.y + a.vy);
+  return (uint32_t)(dx * dx) < dist * dist && (uint32_t)(dy * dy) < dist * dist;
+}
+
+static Pairs brutePairs(const std::vector<Particle> &p, uint32_t baseDist, bool adv) {
+  Pairs pairs;
+  for (uint32_t i = 0; i < p.size(); i++) {
+    if (!p[i].alive || !p[i].collide) continue;
+    for (uint32_t j = i + 1; j < p.size(); j++)
+      if (p[j].alive && p[j].collide && close(p[i], p[j], collDist(p[i], p[j], baseDist, adv))) pairs.insert({i, j});
+  }
+  return pairs;
+}
+
+static Pairs gridPairs(const std::vector<Particle> &p, int32_t maxX, int32_t maxY, uint32_t baseDist, bool adv, uint32_t maxCells, std::vector<uint16_t> &scratch, size_t *checked = nullptr) {
+  uint32_t maxDist = baseDist + (adv ? 255 : 0);
+  uint32_t cellShift = PS_P_RADIUS_SHIFT;
+  while ((1U << cellShift) < maxDist) cellShift++;
+  uint32_t gridW, gridH;
+  cellShift = psGridSize(maxX, maxY, cellShift, maxCells, gridW, gridH);
+  const uint32_t numCells = gridW * gridH;
+  scratch.resize(numCells + 1 + p.size());
+  uint16_t *cellStart = scratch.data(), *sorted = cellStart + numCells + 1;
+  psGridSort(cellStart, sorted, numCells, p.size(), [&](uint32_t i) -> uint32_t {
+    if (!p[i].alive || !p[i].collide) return PS_GRID_SKIP;
+    int32_t px = clamp(p[i].x + p[i].vx, 0, maxX), py = clamp(p[i].y + p[i].vy, 0, maxY);
+    return (py >> cellShift) * gridW + (px >> cellShift);
+  });
+  Pairs pairs;
+  psGridPairs(cellStart, sorted, gridW, gridH, [&](uint32_t i, uint32_t j) {
+    if (checked) (*checked)++;
+    if (close(p[i], p[j], collDist(p[i], p[j], baseDist, adv))) {
+      bool dup = !pairs.insert({i < j ? i : j, i < j ? j : i}).second;
+      CHECK(!dup, "pair %u %u checked twice", i, j);
+    }
+  });
+  return pairs;
+}
+
+static std::vector<Particle> makeParticles(uint32_t n, int32_t maxX, int32_t maxY) {
+  std::vector<Particle> p(n);
+  for (auto &q : p) {
+    q.x = rand() % (maxX + 129) - 64; // particles slightly out of frame are still rendered and collide
+    q.y = rand() % (maxY + 129) - 64;
+    q.vx = rand() % 241 - 120;
+    q.vy = rand() % 241 - 120;
+    q.alive = rand() % 8;
+    q.collide = rand() % 16;
+    q.size = rand() % 4 ? rand() % 64 : rand() % 256;
+  }
+  return p;
+}
+
+int main() {
+  std::vector<uint16_t> scratch;
+  // matrix sizes (incl. a non square one and one exceeding the cell limit), global sizes 0..255, with and without individual sizes
+  const uint32_t dims[][2] = {{8, 8}, {16, 16}, {32, 32}, {64, 16}, {128, 128}};
+  for (unsigned run = 0; run < 200; run++) {
+    const uint32_t *d = dims[run % 5];
+    int32_t maxX = d[0] * 64 - 1, maxY = d[1] * 64 - 1;
+    uint32_t psize = run % 3 ? 0 : rand() % 256;
+    uint32_t hardRadius = psize > 1 ? (psize > PS_P_MINHARDRADIUS ? psize : PS_P_MINHARDRADIUS) : PS_P_MINHARDRADIUS >> (psize == 0);
+    bool adv = run & 1;
+    std::vector<Particle> p = makeParticles(50 + rand() % 1000, maxX, maxY);
+    Pairs brute = brutePairs(p, hardRadius << 1, adv);
+    Pairs grid = gridPairs(p, maxX, maxY, hardRadius << 1, adv, run & 2 ? 256 : 1024, scratch);
+    CHECK(grid == brute, "run %u (%ux%u, size %u%s): grid found %u pairs, brute-force %u", run, d[0], d[1], psize, adv ? " individual" : "",
+      (unsigned)grid.size(), (unsigned)brute.size());
+  }
+
+  // benchmark: candidate pairs and time of the grid vs. all pairs on a 32x32 matrix
+  int32_t maxX = 32 * 64 - 1, maxY = 32 * 64 - 1;
+  for (uint32_t n : {250U, 1000U, 2000U}) {
+    std::vector<Particle> p = makeParticles(n, maxX, maxY);
+    size_t checked = 0;
+    gridPairs(p, maxX, maxY, 128, false, 1024, scratch, &checked);
+    const unsigned reps = 20;
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < reps; r++) gridPairs(p, maxX, maxY, 128, false, 1024, scratch);
+    auto t1 = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < reps; r++) brutePairs(p, 128, false);
+    auto t2 = std::chrono::steady_clock::now();
+    printf("%u particles 32x32: grid checks %u pairs (all pairs %u), %.0f us vs brute-force %.0f us\n", n, (unsigned)checked, n * (n - 1) / 2,
+      std::chrono::duration<double, std::micro>(t1 - t0).count() / reps, std::chrono::duration<double, std::micro>(t2 - t1).count() / reps);
+  }
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
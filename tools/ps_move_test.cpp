@@ -0,0 +1,171 @@
+/*
+ * Host test and benchmark for the batched 2D particle move kernel (wled00/ps_move.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/ps_move_test tools/ps_move_test.cpp && /tmp/ps_move_test
+ * compares psMoveParticles() with the per-particle ParticleSystem2D::particleMoveUpdate() (copied below without individual
+ * sizes) and the shared force counter of applyForce() for all particles with the previous per-particle application
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "../wled00/ps_move.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+#define PS_P_HALFRADIUS 32
+
+// same layout as in FXparticleSystem.h
+typedef struct { int16_t x, y; uint16_t ttl; int8_t vx, vy; uint8_t hue, sat; } PSparticle;
+typedef union {
+  struct { bool outofbounds : 1; bool collide : 1; bool perpetual : 1; bool custom : 5; };
+  uint8_t asByte;
+} PSparticleFlags;
+
+// ParticleSystem2D::bounce() with a deterministic random source
+struct Bouncer {
+  uint8_t wallHardness, wallRoughness;
+  uint32_t hardRadius, seed;
+  uint16_t random16(uint32_t lim) { seed = seed * 1103515245 + 12345; return ((seed >> 16) * lim) >> 16; }
+  void operator()(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition) {
+    incomingspeed = -incomingspeed;
+    incomingspeed = (incomingspeed * wallHardness + 128) >> 8;
+    if (position < (int32_t)hardRadius) position = hardRadius;
+    else position = maxposition - hardRadius;
+    if (wallRoughness) {
+      int32_t incomingspeed_abs = abs((int32_t)incomingspeed);
+      int32_t totalspeed = incomingspeed_abs + abs((int32_t)parallelspeed);
+      int32_t donatespeed = ((random16(incomingspeed_abs << 1) - incomingspeed_abs) * (int32_t)wallRoughness) / (int32_t)255;
+      parallelspeed = limitSpeed((int32_t)parallelspeed + donatespeed);
+      donatespeed = int8_t(totalspeed - abs(parallelspeed));
+      incomingspeed = incomingspeed > 0 ? donatespeed : -donatespeed;
+    }
+  }
+};
+
+// ParticleSystem2D::particleMoveUpdate() without advanced properties (reference)
+static void particleMoveUpdate(PSparticle &part, PSparticleFlags &partFlags, const PSMoveSettings &o, Bouncer &bounce) {
+  if (part.ttl > 0) {
+    if (!partFlags.perpetual) part.ttl--;
+    if (o.colorByAge) part.hue = part.ttl < 255 ? part.ttl : 255;
+    int32_t renderradius = PS_P_HALFRADIUS;
+    int32_t newX = part.x + (int32_t)part.vx;
+    int32_t newY = part.y + (int32_t)part.vy;
+    partFlags.outofbounds = false;
+    if (o.bounceY) {
+      if ((newY < (int32_t)o.hardRadius) || ((newY > (int32_t)(o.maxY - o.hardRadius)) && !o.useGravity))
+        bounce(part.vy, part.vx, newY, o.maxY);
+    }
+    if (!checkBoundsAndWrap(newY, o.maxY, renderradius, o.wrapY)) {
+      partFlags.outofbounds = true;
+      if (o.killoutofbounds) {
+        if (newY < 0) part.ttl = 0;
+        else if (!o.useGravity) part.ttl = 0;
+      }
+    }
+    if (part.ttl) {
+      if (o.bounceX) {
+        if ((newX < (int32_t)o.hardRadius) || (newX > (int32_t)(o.maxX - o.hardRadius)))
+          bounce(part.vx, part.vy, newX, o.maxX);
+      }
+      else if (!checkBoundsAndWrap(newX, o.maxX, renderradius, o.wrapX)) {
+        partFlags.outofbounds = true;
+        if (o.killoutofbounds) part.ttl = 0;
+      }
+    }
+    part.x = (int16_t)newX;
+    part.y = (int16_t)newY;
+  }
+}
+
+static void makeParticles(std::vector<PSparticle> &p, std::vector<PSparticleFlags> &f, int32_t maxX, int32_t maxY) {
+  for (size_t i = 0; i < p.size(); i++) {
+    p[i].x = rand() % (maxX + 513) - 256;
+    p[i].y = rand() % (maxY + 513) - 256;
+    p[i].vx = rand() % 241 - 120;
+    p[i].vy = rand() % 241 - 120;
+    p[i].ttl = rand() % 4 ? rand() % 600 : 0;
+    p[i].hue = rand();
+    p[i].sat = rand();
+    f[i].asByte = rand() & 0xFC; // in bounds, random perpetual
+  }
+}
+
+int main() {
+  // all setting combinations on random systems, several frames each
+  for (unsigned run = 0; run < 512; run++) {
+    PSMoveSettings s;
+    s.maxX = (8 + rand() % 120) * 64 - 1;
+    s.maxY = (8 + rand() % 120) * 64 - 1;
+    s.hardRadius = run & 64 ? 32 : 64 + rand() % 200;
+    s.renderRadius = PS_P_HALFRADIUS;
+    s.colorByAge = run & 1; s.bounceX = run & 2; s.bounceY = run & 4; s.wrapX = run & 8; s.wrapY = run & 16;
+    s.killoutofbounds = run & 32; s.useGravity = run & 128;
+    Bouncer b1 = {(uint8_t)rand(), (uint8_t)(run & 256 ? rand() : 0), (uint32_t)s.hardRadius, (uint32_t)run};
+    Bouncer b2 = b1;
+    std::vector<PSparticle> p(200 + rand() % 300);
+    std::vector<PSparticleFlags> f(p.size());
+    makeParticles(p, f, s.maxX, s.maxY);
+    std::vector<PSparticle> q = p;
+    std::vector<PSparticleFlags> g = f;
+    for (unsigned frame = 0; frame < 20; frame++) {
+      for (size_t i = 0; i < p.size(); i++) particleMoveUpdate(p[i], f[i], s, b1);
+      psMoveParticles(q.data(), g.data(), q.size(), s, [&](int8_t &a, int8_t &b, int32_t &pos, int32_t max) { b2(a, b, pos, max); });
+    }
+    bool same = memcmp(p.data(), q.data(), p.size() * sizeof(PSparticle)) == 0;
+    for (size_t i = 0; i < f.size() && same; i++) same = f[i].asByte == g[i].asByte;
+    CHECK(same, "run %u: batched move differs from particleMoveUpdate()", run);
+  }
+
+  // global force: one counter shared by all particles gives every particle the same velocity change
+  for (int force = -127; force <= 127; force++) {
+    std::vector<PSparticle> p(64), q;
+    std::vector<PSparticleFlags> f(64);
+    makeParticles(p, f, 2047, 2047);
+    q = p;
+    uint8_t counterOld = 0x5A, counterNew = 0x5A;
+    for (unsigned frame = 0; frame < 40; frame++) {
+      // previous applyForce(xforce, yforce): per particle with a copy of the system counter
+      uint8_t tempcounter = counterOld;
+      for (auto &part : p) {
+        tempcounter = counterOld;
+        uint8_t xc = tempcounter & 0x0F, yc = tempcounter >> 4;
+        int32_t dvx = calcForce_dv(force, xc), dvy = calcForce_dv(-force / 2, yc);
+        tempcounter = (xc & 0x0F) | ((yc << 4) & 0xF0);
+        part.vx = limitSpeed((int32_t)part.vx + dvx);
+        part.vy = limitSpeed((int32_t)part.vy + dvy);
+      }
+      counterOld = tempcounter;
+      // current: velocity change calculated once
+      uint8_t xc = counterNew & 0x0F, yc = counterNew >> 4;
+      int32_t dvx = calcForce_dv(force, xc), dvy = calcForce_dv(-force / 2, yc);
+      counterNew = (xc & 0x0F) | ((yc << 4) & 0xF0);
+      for (auto &part : q) {
+        part.vx = limitSpeed((int32_t)part.vx + dvx);
+        part.vy = limitSpeed((int32_t)part.vy + dvy);
+      }
+    }
+    CHECK(counterOld == counterNew && memcmp(p.data(), q.data(), p.size() * sizeof(PSparticle)) == 0, "force %d differs", force);
+  }
+
+  // benchmark: 2000 particles on a 64x64 matrix bouncing off all walls
+  PSMoveSettings s = {64 * 64 - 1, 64 * 64 - 1, 64, PS_P_HALFRADIUS, true, true, true, false, false, false, false};
+  Bouncer b = {240, 0, 64, 1};
+  std::vector<PSparticle> p(2000);
+  std::vector<PSparticleFlags> f(p.size());
+  makeParticles(p, f, s.maxX, s.maxY);
+  for (auto &part : p) part.ttl = 60000;
+  const unsigned reps = 20000;
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < reps; r++) for (size_t i = 0; i < p.size(); i++) particleMoveUpdate(p[i], f[i], s, b);
+  auto t1 = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < reps; r++) psMoveParticles(p.data(), f.data(), p.size(), s, [&](int8_t &a, int8_t &c, int32_t &pos, int32_t max) { b(a, c, pos, max); });
+  auto t2 = std::chrono::steady_clock::now();
+  printf("2000 particles: per-particle move %.2f ns/particle, batched %.2f ns/particle\n",
+    std::chrono::duration<double, std::nano>(t1 - t0).count() / reps / p.size(), std::chrono::duration<double, std::nano>(t2 - t1).count() / reps / p.size());
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Host test and benchmark for tile ordered particle rendering (ParticleSystem2D::render() using wled00/ps_grid.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/ps_render_order_test tools/ps_render_order_test.cpp && /tmp/ps_render_order_test
+ * the benchmark renders 2x2 pixel particles in particle order and in tile order (including the sort), host caches are much
+ * larger than the ESP32's so the difference is smaller here than with a framebuffer in PSRAM
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include "../wled00/ps_grid.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+#define PS_P_RADIUS_SHIFT 6
+#define PS_RENDER_TILESHIFT 4
+
+typedef struct { int16_t x, y; uint16_t ttl; bool outofbounds; } Particle;
+
+static int32_t clamp(int32_t v, int32_t lo, int32_t hi) { return v < lo ? lo : v > hi ? hi : v; }
+
+// tile order as set up in render(), returns number of particles to render
+static uint32_t tileOrder(const std::vector<Particle> &p, int32_t maxX, int32_t maxY, uint32_t maxCells, std::vector<uint16_t> &scratch, uint16_t *&order, uint32_t *shiftOut = nullptr, uint32_t *wOut = nullptr) {
+  uint32_t tilesW, tilesH;
+  const uint32_t tileShift = psGridSize(maxX, maxY, PS_P_RADIUS_SHIFT + PS_RENDER_TILESHIFT, maxCells, tilesW, tilesH);
+  const uint32_t numTiles = tilesW * tilesH;
+  scratch.resize(numTiles + 1 + p.size());
+  order = scratch.data() + numTiles + 1;
+  if (shiftOut) *shiftOut = tileShift;
+  if (wOut) *wOut = tilesW;
+  return psGridSort(scratch.data(), order, numTiles, p.size(), [&](uint32_t i) -> uint32_t {
+    if (p[i].ttl == 0 || p[i].outofbounds) return PS_GRID_SKIP;
+    return (clamp(p[i].y, 0, maxY) >> tileShift) * tilesW + (clamp(p[i].x, 0, maxX) >> tileShift);
+  });
+}
+
+// adds a 2x2 pixel particle (framebuffer y is flipped like in renderParticle())
+static inline void renderParticle(uint32_t *fb, uint32_t w, uint32_t h, const Particle &p) {
+  int32_t x = p.x >> PS_P_RADIUS_SHIFT, y = p.y >> PS_P_RADIUS_SHIFT;
+  uint32_t c = p.ttl * 0x010101;
+  for (int dy = 0; dy < 2; dy++) for (int dx = 0; dx < 2; dx++) {
+    int32_t px = x + dx, py = y + dy;
+    if (px < 0 || py < 0 || px >= (int32_t)w || py >= (int32_t)h) continue;
+    fb[px + (h - 1 - py) * w] += c;
+  }
+}
+
+static std::vector<Particle> makeParticles(uint32_t n, int32_t maxX, int32_t maxY) {
+  std::vector<Particle> p(n);
+  for (auto &q : p) {
+    q.x = rand() % (maxX + 65) - 32;
+    q.y = rand() % (maxY + 65) - 32;
+    q.ttl = rand() % 8 ? 1 + rand() % 255 : 0;
+    q.outofbounds = rand() % 16 == 0;
+  }
+  return p;
+}
+
+int main() {
+  std::vector<uint16_t> scratch;
+  const uint32_t dims[][2] = {{32, 64}, {64, 64}, {128, 32}, {256, 256}, {1000, 8}};
+  for (unsigned run = 0; run < 100; run++) {
+    const uint32_t w = dims[run % 5][0], h = dims[run % 5][1];
+    int32_t maxX = w * 64 - 1, maxY = h * 64 - 1;
+    std::vector<Particle> p = makeParticles(100 + rand() % 3000, maxX, maxY);
+    uint16_t *order;
+    uint32_t shift, tilesW;
+    uint32_t count = tileOrder(p, maxX, maxY, run & 1 ? 256 : 1024, scratch, order, &shift, &tilesW);
+    // every live particle in frame exactly once, in tile order, particle order kept within a tile
+    std::vector<uint8_t> seen(p.size(), 0);
+    uint32_t live = 0, prevTile = 0, prevIdx = 0;
+    bool ok = true;
+    for (auto &q : p) live += q.ttl && !q.outofbounds;
+    for (uint32_t n = 0; n < count && ok; n++) {
+      uint32_t i = order[n];
+      uint32_t tile = (clamp(p[i].y, 0, maxY) >> shift) * tilesW + (clamp(p[i].x, 0, maxX) >> shift);
+      ok = i < p.size() && !seen[i]++ && p[i].ttl && !p[i].outofbounds && (n == 0 || tile > prevTile || (tile == prevTile && i > prevIdx));
+      prevTile = tile; prevIdx = i;
+    }
+    CHECK(ok && count == live, "run %u (%ux%u): order broken or %u of %u particles", run, w, h, count, live);
+    // accumulated frame does not depend on the order
+    std::vector<uint32_t> a(w * h, 0), b(w * h, 0);
+    for (auto &q : p) if (q.ttl && !q.outofbounds) renderParticle(a.data(), w, h, q);
+    for (uint32_t n = 0; n < count; n++) renderParticle(b.data(), w, h, p[order[n]]);
+    CHECK(a == b, "run %u: frames differ", run);
+  }
+
+  // benchmark: particle order vs. tile order (sort included)
+  for (uint32_t size : {64U, 128U, 256U}) {
+    int32_t maxX = size * 64 - 1, maxY = size * 64 - 1;
+    std::vector<Particle> p = makeParticles(4000, maxX, maxY);
+    std::vector<uint32_t> fb(size * size);
+    const unsigned reps = 500;
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < reps; r++)
+      for (auto &q : p) if (q.ttl && !q.outofbounds) renderParticle(fb.data(), size, size, q);
+    auto t1 = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < reps; r++) {
+      uint16_t *order;
+      uint32_t count = tileOrder(p, maxX, maxY, 1024, scratch, order);
+      for (uint32_t n = 0; n < count; n++) renderParticle(fb.data(), size, size, p[order[n]]);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    printf("4000 particles %ux%u: particle order %.1f us, tile order %.1f us per frame\n", size, size,
+      std::chrono::duration<double, std::micro>(t1 - t0).count() / reps, std::chrono::duration<double, std::micro>(t2 - t1).count() / reps);
+  }
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Host test of the adaptive effect quality controller against a synthetic load (wled00/quality.h)
+ * build & run: g++ -O2 -std=c++17 -o /tmp/quality_test tools/quality_test.cpp && /tmp/quality_test
+ * effect time per frame = fixed part + part proportional to the quality level, with +-10% noise and load steps
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "../wled00/quality.h"
+
+static int failures = 0;
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+struct Load { unsigned fixedUs, fullUs; }; // effect time at quality 0 (not scaled) and additional time at full quality
+
+struct Sim {
+  uint8_t quality = 255;
+  uint32_t smoothed = 0;
+  unsigned frameTime; // ms
+  unsigned over = 0, frames = 0, qMin = 255, qMax = 0;
+  explicit Sim(unsigned ft) : frameTime(ft) {}
+  unsigned effectTime(const Load &l) {
+    int t = l.fixedUs + (l.fullUs * quality) / 255;
+    return t + t * (rand() % 21 - 10) / 100; // +-10% noise
+  }
+  // runs n frames, statistics are collected for the frames after settle
+  void run(const Load &l, unsigned n, unsigned settle) {
+    over = frames = 0; qMin = 255; qMax = 0;
+    for (unsigned f = 0; f < n; f++) {
+      unsigned t = effectTime(l);
+      quality = updateQualityLevel(quality, smoothed, t, frameTime);
+      if (f < settle) continue;
+      frames++;
+      if (t > frameTime * 1000) over++;
+      if (quality < qMin) qMin = quality;
+      if (quality > qMax) qMax = quality;
+    }
+  }
+};
+
+int main() {
+  const unsigned frameTime = 25; // 40 FPS
+  Sim s(frameTime);
+
+  // light load: full quality
+  s.run({2000, 10000}, 300, 0);
+  CHECK(s.qMin == 255, "light load lowered quality to %u", s.qMin);
+  printf("light load (12 ms at full quality): quality %u..%u\n", s.qMin, s.qMax);
+
+  // heavy load (45 ms at full quality): settles within 30 frames, frames stay within frame time, no oscillation
+  s.run({5000, 40000}, 30, 0);
+  unsigned settled = s.quality;
+  s.run({5000, 40000}, 600, 0);
+  CHECK(s.over * 100 <= s.frames * 2, "heavy load: %u of %u frames over frame time", s.over, s.frames);
+  CHECK(s.qMax - s.qMin <= 24, "heavy load: quality oscillates %u..%u", s.qMin, s.qMax);
+  CHECK(settled <= s.qMax + 8, "heavy load: quality %u after 30 frames, steady state %u..%u", settled, s.qMin, s.qMax);
+  printf("heavy load (45 ms at full quality, %u ms frame): quality %u after 30 frames, steady %u..%u, %u/%u frames over frame time\n",
+    frameTime, settled, s.qMin, s.qMax, s.over, s.frames);
+
+  // load drops again: back to full quality
+  unsigned frames = 0;
+  while (s.quality < 255 && frames < 1000) { s.run({2000, 10000}, 1, 0); frames++; }
+  CHECK(s.quality == 255 && frames <= 128, "recovery took %u frames (quality %u)", frames, s.quality);
+  printf("recovery to full quality: %u frames\n", frames);
+
+  // short spikes (one slow frame every 50) do not lower quality much
+  s.run({2000, 10000}, 10, 0);
+  unsigned qMin = 255;
+  for (unsigned f = 0; f < 500; f++) {
+    s.run(f % 50 ? Load{2000, 10000} : Load{2000, 60000}, 1, 0);
+    if (s.quality < qMin) qMin = s.quality;
+  }
+  CHECK(qMin >= 200, "single slow frames lowered quality to %u", qMin);
+  printf("single slow frames (62 ms every 50th frame): lowest quality %u\n", qMin);
+
+  // load that cannot be met (fixed part alone exceeds frame time): quality stops at QUALITY_LEVEL_MIN
+  s.run({30000, 20000}, 200, 100);
+  CHECK(s.qMin == QUALITY_LEVEL_MIN && s.qMax == QUALITY_LEVEL_MIN, "impossible load: quality %u..%u", s.qMin, s.qMax);
+
+  if (failures) { printf("%d checks failed\n", failures); return 1; }
+  printf("all checks passed\n");
+  return 0;
+}
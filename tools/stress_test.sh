@@ -2,12 +2,13 @@
 # Some web server stress tests
 #
 # Perform a large number of parallel requests, stress testing the web server
-# TODO: some kind of performance metrics
+# Reports requests/s and a count of HTTP response codes (304 = served from ETag cache, 503 = buffer unavailable)
 
 # Accepts three command line arguments:
 # - first argument - mandatory - IP or hostname of target server
 # - second argument - target type (optional)
 # - third argument - xfer count (for replicated targets) (optional)
+# Set ETAG=1 to send each request If-None-Match with the ETag of a first request to the same target (simulates polling dashboards)
 HOST=$1
 declare -n TARGET_STR="${2:-JSON_LARGER}_TARGETS"
 REPLICATE_COUNT=$(("${3:-10}"))
@@ -26,13 +27,36 @@ function replicate() {
 read -a JSON_TINY_TARGETS <<< $(replicate "json/nodes")
 read -a JSON_SMALL_TARGETS <<< $(replicate "json/info")
 read -a JSON_LARGE_TARGETS <<< $(replicate "json/si")
+read -a JSON_STATE_TARGETS <<< $(replicate "json/state")
 read -a JSON_LARGER_TARGETS <<< $(replicate "json/fxdata")
 read -a INDEX_TARGETS <<< $(replicate "")
 
 # Expand target URLS to full arguments for curl
 TARGETS=(${TARGET_STR[@]})
 #echo "${TARGETS[@]}"
-FULL_TGT_OPTIONS=$(printf "http://${HOST}/%s -o /dev/null " "${TARGETS[@]}")
+if [ "${ETAG:-0}" != "0" ]; then
+  # every target has its own ETag: fetch it once per target (query used for replication is ignored by the server)
+  # and pass it in a separate curl option group (--next) for each URL
+  declare -A ETAGS
+  FULL_TGT_OPTIONS=""
+  for TGT in "${TARGETS[@]}"; do
+    BASE="${TGT%%\?*}"
+    if [ -z "${ETAGS[${BASE}]+x}" ]; then
+      ETAGS[${BASE}]=$(curl -s -D - -o /dev/null "http://${HOST}/${BASE}" | tr -d '\r' | sed -n 's/^[Ee][Tt]ag: //p')
+    fi
+    [ -n "${FULL_TGT_OPTIONS}" ] && FULL_TGT_OPTIONS="${FULL_TGT_OPTIONS} --next"
+    FULL_TGT_OPTIONS="${FULL_TGT_OPTIONS} --compressed ${CURL_PRINT_RESPONSE_ARGS}"
+    [ -n "${ETAGS[${BASE}]}" ] && FULL_TGT_OPTIONS="${FULL_TGT_OPTIONS} -H If-None-Match:${ETAGS[${BASE}]}"
+    FULL_TGT_OPTIONS="${FULL_TGT_OPTIONS} http://${HOST}/${TGT} -o /dev/null"
+  done
+else
+  FULL_TGT_OPTIONS=$(printf "http://${HOST}/%s -o /dev/null " "${TARGETS[@]}")
+fi
 #echo ${FULL_TGT_OPTIONS}
 
-time curl ${CURL_ARGS} ${FULL_TGT_OPTIONS}
+START=$(date +%s.%N)
+CODES=$(curl ${CURL_ARGS} ${CURL_PRINT_RESPONSE_ARGS} ${FULL_TGT_OPTIONS})
+END=$(date +%s.%N)
+
+echo "${CODES}" | sort | uniq -c
+awk -v n="${#TARGETS[@]}" -v s="${START}" -v e="${END}" 'BEGIN { t = e - s; printf "%d requests in %.3f s: %.1f requests/s\n", n, t, (t > 0 ? n / t : 0) }'
@@ -13,6 +13,8 @@
 #include "wled.h"
 #include "FX.h"
 #include "fcn_declare.h"
+#include "fx_julia.h"
+#include "fx_life.h"
 
 #if !(defined(WLED_DISABLE_PARTICLESYSTEM2D) && defined(WLED_DISABLE_PARTICLESYSTEM1D))
   #include "FXparticleSystem.h"
@@ -2258,10 +2260,12 @@ uint16_t mode_noise16_2() {
   unsigned scale = 1000;                                        // the "zoom factor" for the noise
   SEGENV.step += (1 + (SEGMENT.speed >> 1));
 
+  uint16_t noiseRow[32];                                        // noise is calculated in batches of 32 pixels
   for (unsigned i = 0; i < SEGLEN; i++) {
     unsigned shift_x = SEGENV.step >> 6;                        // x as a function of time
     uint32_t real_x = (i + shift_x) * scale;                    // calculate the coordinates within the noise field
-    unsigned noise = perlin16(real_x, 0, 4223) >> 8;            // get the noise data and scale it down
+    if ((i & 31) == 0) perlin16Row(noiseRow, std::min(32U, SEGLEN - i), real_x, scale, 0, 4223);
+    unsigned noise = noiseRow[i & 31] >> 8;                     // get the noise data and scale it down
     unsigned index = sin8_t(noise * 3);                           // map led color based on noise data
 
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise));
@@ -2296,8 +2300,10 @@ static const char _data_FX_MODE_NOISE16_3[] PROGMEM = "Noise 3@!;!;!;;pal=35";
 //https://github.com/aykevl/ledstrip-spark/blob/master/ledstrip.ino
 uint16_t mode_noise16_4() {
   uint32_t stp = (strip.now * SEGMENT.speed) >> 7;
+  uint16_t noiseRow[32]; // noise is calculated in batches of 32 pixels
   for (unsigned i = 0; i < SEGLEN; i++) {
-    int index = perlin16(uint32_t(i) << 12, stp);
+    if ((i & 31) == 0) perlin16Row(noiseRow, std::min(32U, SEGLEN - i), uint32_t(i) << 12, 1U << 12, stp);
+    int index = noiseRow[i & 31];
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0));
   }
   return FRAMETIME;
@@ -5196,19 +5202,32 @@ static const char _data_FX_MODE_2DFRIZZLES[] PROGMEM = "Frizzles@X frequency,Y f
 ///////////////////////////////////////////
 //   2D Cellular Automata Game of life   //
 ///////////////////////////////////////////
-typedef struct Cell {
-    uint8_t alive : 1, faded : 1, toggleStatus : 1, edgeCell: 1, oscillatorCheck : 1, spaceshipCheck : 1, unused : 2;
-} Cell;
+// cell states are stored in bit planes (one bit per cell, rows padded to 32 bit words) so neighbours of 32 cells are counted at once
+// the alive plane is double buffered, cells are only redrawn if they change or are fading out
+typedef struct GameOfLife {
+  uint32_t bgColor; // background color faded cells were drawn with
+  uint32_t current; // index of the alive plane holding the current generation
+} GameOfLife;
 
 uint16_t mode_2Dgameoflife(void) { // Written by Ewoud Wijma, inspired by https://natureofcode.com/book/chapter-7-cellular-automata/ 
                                    // and https://github.com/DougHaber/nlife-color , Modified By: Brandon Butler
   if (!strip.isMatrix || !SEGMENT.is2D()) return mode_static(); // not a 2D set-up
   const int cols = SEG_W, rows = SEG_H;
-  const unsigned maxIndex = cols * rows;
-
-  if (!SEGENV.allocateData(SEGMENT.length() * sizeof(Cell))) return mode_static(); // allocation failed
-
-  Cell *cells = reinterpret_cast<Cell*> (SEGENV.data);
+  const unsigned wordsPerRow = (cols + 31) >> 5;
+  const unsigned planeSize = wordsPerRow * rows; // in words
+  const unsigned lastWord = wordsPerRow - 1;
+  const unsigned lastBit = (cols - 1) & 31;
+  const uint32_t lastMask = 0xFFFFFFFFU >> (31 - lastBit); // valid cells in last word of a row
+
+  if (!SEGENV.allocateData(sizeof(GameOfLife) + 5 * planeSize * sizeof(uint32_t))) return mode_static(); // allocation failed
+
+  GameOfLife *gol = reinterpret_cast<GameOfLife*>(SEGENV.data);
+  uint32_t *alivePlanes[2];
+  alivePlanes[0]          = reinterpret_cast<uint32_t*>(SEGENV.data + sizeof(GameOfLife));
+  alivePlanes[1]          = alivePlanes[0] + planeSize;
+  uint32_t *fadedPlane    = alivePlanes[1] + planeSize;
+  uint32_t *oscillatorChk = fadedPlane + planeSize;
+  uint32_t *spaceshipChk  = oscillatorChk + planeSize;
 
   uint16_t& generation = SEGENV.aux0, &gliderLength = SEGENV.aux1; // rename aux variables for clarity
   bool mutate = SEGMENT.check3;
@@ -5234,112 +5253,131 @@ uint16_t mode_2Dgameoflife(void) { // Written by Ewoud Wijma, inspired by https:
     generation = 1;
     paused = true;
     //Setup Grid
-    memset(cells, 0, maxIndex * sizeof(Cell));
+    memset(alivePlanes[0], 0, 5 * planeSize * sizeof(uint32_t));
+    gol->current = 0;
+    gol->bgColor = bgColor;
 
-    for (unsigned i = 0; i < maxIndex; i++) {
+    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
       bool isAlive = !hw_random8(3); // ~33%
-      cells[i].alive = isAlive;
-      cells[i].faded = !isAlive;
-      unsigned x = i % cols, y = i / cols;
-      cells[i].edgeCell = (x == 0 || x == cols-1 || y == 0 || y == rows-1);
+      const unsigned w = y * wordsPerRow + (x >> 5);
+      if (isAlive) alivePlanes[0][w] |= 1U << (x & 31);
+      else         fadedPlane[w]     |= 1U << (x & 31);
 
-      SEGMENT.setPixelColor(i, isAlive ? SEGMENT.color_from_palette(hw_random8(), false, PALETTE_SOLID_WRAP, 0) : bgColor);
+      SEGMENT.setPixelColorXY(x, y, isAlive ? SEGMENT.color_from_palette(hw_random8(), false, PALETTE_SOLID_WRAP, 0) : bgColor);
     }
   }
 
+  uint32_t *alive = alivePlanes[gol->current];
+
   if (paused || (strip.now - SEGENV.step < 1000 / map(SEGMENT.speed,0,255,1,42))) {
-    // Redraw if paused or between updates to remove blur
-    for (unsigned i = maxIndex; i--; ) {
-      if (!cells[i].alive) {
-        uint32_t cellColor = SEGMENT.getPixelColor(i);
+    // Redraw if paused or between updates to remove blur, faded cells only need redrawing if background color changed
+    const bool bgChanged = gol->bgColor != bgColor;
+    gol->bgColor = bgColor;
+    for (unsigned i = 0; i < planeSize; i++) {
+      uint32_t dead = ~alive[i] & (i % wordsPerRow == lastWord ? lastMask : 0xFFFFFFFFU);
+      uint32_t redraw = bgChanged ? dead : dead & ~fadedPlane[i];
+      while (redraw) {
+        const unsigned bit = 31 - __builtin_clz(redraw);
+        redraw &= ~(1U << bit);
+        const int x = ((i % wordsPerRow) << 5) + bit, y = i / wordsPerRow;
+        uint32_t cellColor = SEGMENT.getPixelColorXY(x, y);
         if (cellColor != bgColor) {
           uint32_t newColor;
-          bool needsColor = false;
-          if (cells[i].faded) { newColor = bgColor; needsColor = true; }
+          if (fadedPlane[i] & (1U << bit)) newColor = bgColor;
           else {
-            uint32_t blended = color_blend(cellColor, bgColor, 2);
-            if (blended == cellColor) { blended = bgColor; cells[i].faded = 1; }
-            newColor = blended; needsColor = true;
+            newColor = color_blend(cellColor, bgColor, 2);
+            if (newColor == cellColor) { newColor = bgColor; fadedPlane[i] |= 1U << bit; }
           }
-          if (needsColor) SEGMENT.setPixelColor(i, newColor);
+          SEGMENT.setPixelColorXY(x, y, newColor);
         }
       }
     }
     return FRAMETIME;
   }
 
-  // Repeat detection
+  // next generation starts as a copy, cells that change are toggled in it
+  uint32_t *next = alivePlanes[gol->current ^ 1];
+  memcpy(next, alive, planeSize * sizeof(uint32_t));
+
+  // Repeat detection (padding bits are always 0)
   bool updateOscillator = generation % 16 == 0;
   bool updateSpaceship  = gliderLength && generation % gliderLength == 0;
   bool repeatingOscillator = true, repeatingSpaceship = true, emptyGrid = true;
+  for (unsigned i = 0; i < planeSize; i++) {
+    if (alive[i]) emptyGrid = false;
+    if (oscillatorChk[i] != alive[i]) repeatingOscillator = false;
+    if (spaceshipChk[i]  != alive[i]) repeatingSpaceship  = false;
+    if (updateOscillator) oscillatorChk[i] = alive[i];
+    if (updateSpaceship)  spaceshipChk[i]  = alive[i];
+  }
 
-  unsigned cIndex = maxIndex-1;
-  for (unsigned y = rows; y--; ) for (unsigned x = cols; x--; cIndex--) {
-    Cell& cell = cells[cIndex];
-
-    if (cell.alive) emptyGrid = false;
-    if (cell.oscillatorCheck != cell.alive) repeatingOscillator = false;
-    if (cell.spaceshipCheck  != cell.alive) repeatingSpaceship  = false;
-    if (updateOscillator) cell.oscillatorCheck = cell.alive;
-    if (updateSpaceship)  cell.spaceshipCheck  = cell.alive;
-
-    unsigned neighbors = 0, aliveParents = 0, parentIdx[3];
-    // Count alive neighbors
-    for (int i = -1; i <= 1; i++) for (int j = -1; j <= 1; j++) if (i || j) {
-      int nX = x + j, nY = y + i;
-      if (cell.edgeCell) {
-        nX = (nX + cols) % cols;
-        nY = (nY + rows) % rows;
-      }
-      unsigned nIndex = nX + nY * cols;
-      Cell& neighbor = cells[nIndex];
-      if (neighbor.alive) {
-        neighbors++;
-        if (!neighbor.toggleStatus && neighbors < 4) { // Alive and not dying
-          parentIdx[aliveParents++] = nIndex;
-        }
-      }
-    }
-
-    uint32_t newColor;
-    bool needsColor = false;
-
-    if (cell.alive && (neighbors < 2 || neighbors > 3)) { // Loneliness or Overpopulation
-      cell.toggleStatus = 1;
-      if (blur == 255) cell.faded = 1;
-      newColor = cell.faded ? bgColor : color_blend(SEGMENT.getPixelColor(cIndex), bgColor, blur);
-      needsColor = true;
-    }
-    else if (!cell.alive) {
-      byte mutationRoll = mutate ? hw_random8(128) : 1; // if 0: 3 neighbor births fail and 2 neighbor births mutate
-      if ((neighbors == 3 && mutationRoll) || (mutate && neighbors == 2 && !mutationRoll)) { // Reproduction or Mutation
-        cell.toggleStatus = 1;
-        cell.faded = 0;
+  auto isSet = [&](const uint32_t *plane, int x, int y) -> bool {
+    return plane[y * wordsPerRow + (x >> 5)] & (1U << (x & 31));
+  };
 
-        if (aliveParents) {
-          // Set color based on random neighbor
-          unsigned parentIndex = parentIdx[random8(aliveParents)];
-          birthColor = SEGMENT.getPixelColor(parentIndex);
-        }
-        newColor = birthColor;
-        needsColor = true;
-      }
-      else if (!cell.faded) {// No change, fade dead cells
-          uint32_t cellColor = SEGMENT.getPixelColor(cIndex);
-          uint32_t blended = color_blend(cellColor, bgColor, blur);
-          if (blended == cellColor) { blended = bgColor; cell.faded = 1; }
-          newColor = blended;
+  for (int y = rows; y--; ) {
+    const uint32_t *rowN = alive + ((y + rows - 1) % rows) * wordsPerRow;
+    const uint32_t *rowC = alive + y * wordsPerRow;
+    const uint32_t *rowS = alive + ((y + 1) % rows) * wordsPerRow;
+    for (unsigned w = wordsPerRow; w--; ) {
+      uint32_t two, three; // cells with two/three alive neighbours
+      lifeNeighbourCount(rowN, rowC, rowS, w, lastWord, lastBit, two, three);
+      const uint32_t valid = w == lastWord ? lastMask : 0xFFFFFFFFU;
+      const unsigned i = y * wordsPerRow + w;
+      const uint32_t cells = alive[i];
+      const uint32_t dying = cells & ~(two | three);                              // Loneliness or Overpopulation
+      const uint32_t dead  = ~cells & (three | (mutate ? two : 0) | ~fadedPlane[i]); // possible births and fading cells
+      uint32_t update = (dying | dead) & valid;
+
+      while (update) { // same order as a full scan (backwards) so parent selection and random numbers stay the same
+        const unsigned bit = 31 - __builtin_clz(update);
+        const uint32_t mask = 1U << bit;
+        update &= ~mask;
+        const int x = (w << 5) + bit;
+        uint32_t newColor;
+        bool needsColor = false;
+
+        if (cells & mask) { // dying
+          next[i] &= ~mask;
+          if (blur == 255) fadedPlane[i] |= mask;
+          newColor = (fadedPlane[i] & mask) ? bgColor : color_blend(SEGMENT.getPixelColorXY(x, y), bgColor, blur);
           needsColor = true;
+        } else {
+          byte mutationRoll = mutate ? hw_random8(128) : 1; // if 0: 3 neighbor births fail and 2 neighbor births mutate
+          if (((three & mask) && mutationRoll) || (mutate && (two & mask) && !mutationRoll)) { // Reproduction or Mutation
+            next[i] |= mask;
+            fadedPlane[i] &= ~mask;
+
+            unsigned aliveParents = 0;
+            int parentX[3], parentY[3];
+            for (int dy = -1; dy <= 1; dy++) for (int dx = -1; dx <= 1; dx++) if (dx || dy) {
+              int nX = (x + dx + cols) % cols, nY = (y + dy + rows) % rows;
+              if (isSet(alive, nX, nY) && isSet(next, nX, nY) && aliveParents < 3) { // Alive and not dying
+                parentX[aliveParents] = nX;
+                parentY[aliveParents++] = nY;
+              }
+            }
+            if (aliveParents) {
+              // Set color based on random neighbor
+              unsigned parent = random8(aliveParents);
+              birthColor = SEGMENT.getPixelColorXY(parentX[parent], parentY[parent]);
+            }
+            newColor = birthColor;
+            needsColor = true;
+          }
+          else if (!(fadedPlane[i] & mask)) { // No change, fade dead cells
+            uint32_t cellColor = SEGMENT.getPixelColorXY(x, y);
+            uint32_t blended = color_blend(cellColor, bgColor, blur);
+            if (blended == cellColor) { blended = bgColor; fadedPlane[i] |= mask; }
+            newColor = blended;
+            needsColor = true;
+          }
+        }
+        if (needsColor) SEGMENT.setPixelColorXY(x, y, newColor);
       }
     }
-
-    if (needsColor) SEGMENT.setPixelColor(cIndex, newColor);
-  }
-  // Loop through cells, if toggle, swap alive status
-  for (unsigned i = maxIndex; i--; ) {
-    cells[i].alive ^= cells[i].toggleStatus;
-    cells[i].toggleStatus = 0;
   }
+  gol->current ^= 1; // next generation becomes current
 
   if (repeatingOscillator || repeatingSpaceship || emptyGrid) {
     generation = 0; // reset on next call
@@ -5448,6 +5486,28 @@ uint16_t mode_2DJulia(void) {                           // An animated Julia set
   dx = (xmax - xmin) / (cols);     // Scale the delta x and y values to our matrix size.
   dy = (ymax - ymin) / (rows);
 
+#if WLED_FX_FIXEDPOINT
+  // fixed point version of the loop below (see fx_julia.h)
+  const int32_t reQ = reAl * (1 << JULIA_Q);
+  const int32_t imQ = imAg * (1 << JULIA_Q);
+  const int32_t dxQ = dx * (1 << JULIA_Q);
+  const int32_t dyQ = dy * (1 << JULIA_Q);
+  const int64_t maxCalcQ = (int64_t)maxCalc << (2 * JULIA_Q);
+  int32_t yQ = ymin * (1 << JULIA_Q);
+  for (int j = 0; j < rows; j++) {
+    int32_t xQ = xmin * (1 << JULIA_Q);
+    for (int i = 0; i < cols; i++) {
+      int iter = juliaIterationsQ(xQ, yQ, reQ, imQ, maxIterations, maxCalcQ);
+      if (iter == maxIterations) {
+        SEGMENT.setPixelColorXY(i, j, 0);
+      } else {
+        SEGMENT.setPixelColorXY(i, j, SEGMENT.color_from_palette(iter*255/maxIterations, false, PALETTE_SOLID_WRAP, 0));
+      }
+      xQ += dxQ;
+    }
+    yQ += dyQ;
+  }
+#else
   // Start y
   float y = ymin;
   for (int j = 0; j < rows; j++) {
@@ -5457,23 +5517,7 @@ uint16_t mode_2DJulia(void) {                           // An animated Julia set
     for (int i = 0; i < cols; i++) {
 
       // Now we test, as we iterate z = z^2 + c does z tend towards infinity?
-      float a = x;
-      float b = y;
-      int iter = 0;
-
-      while (iter < maxIterations) {    // Here we determine whether or not we're out of bounds.
-        float aa = a * a;
-        float bb = b * b;
-        float len = aa + bb;
-        if (len > maxCalc) {            // |z| = sqrt(a^2+b^2) OR z^2 = a^2+b^2 to save on having to perform a square root.
-          break;  // Bail
-        }
-
-       // This operation corresponds to z -> z^2+c where z=a+ib c=(x,y). Remember to use 'foil'.
-        b = 2*a*b + imAg;
-        a = aa - bb + reAl;
-        iter++;
-      } // while
+      int iter = juliaIterations(x, y, reAl, imAg, maxIterations, maxCalc);
 
       // We color each pixel based on how long it takes to get to infinity, or black if it never gets there.
       if (iter == maxIterations) {
@@ -5485,6 +5529,7 @@ uint16_t mode_2DJulia(void) {                           // An animated Julia set
     }
     y += dy;
   }
+#endif
   if(SEGMENT.check1)
     SEGMENT.blur(100, true);
 
@@ -5640,12 +5685,12 @@ uint16_t mode_2Dmetaballs(void) {   // Metaballs by Stefan Petrick. Cannot have
       } else {
         SEGMENT.setPixelColorXY(x, y, SEGMENT.color_from_palette(0, false, PALETTE_SOLID_WRAP, 0));
       }
-      // show the 3 points, too
-      SEGMENT.setPixelColorXY(x1, y1, WHITE);
-      SEGMENT.setPixelColorXY(x2, y2, WHITE);
-      SEGMENT.setPixelColorXY(x3, y3, WHITE);
     }
   }
+  // show the 3 points, too
+  SEGMENT.setPixelColorXY(x1, y1, WHITE);
+  SEGMENT.setPixelColorXY(x2, y2, WHITE);
+  SEGMENT.setPixelColorXY(x3, y3, WHITE);
 
   return FRAMETIME;
 } // mode_2Dmetaballs()
@@ -5663,10 +5708,11 @@ uint16_t mode_2Dnoise(void) {                  // By Andrew Tuline
 
   const unsigned scale  = SEGMENT.intensity+2;
 
+  uint8_t noiseRow[cols];
   for (int y = 0; y < rows; y++) {
+    perlin8Row(noiseRow, cols, 0, scale, y * scale, strip.now / (16 - SEGMENT.speed/16));
     for (int x = 0; x < cols; x++) {
-      uint8_t pixelHue8 = perlin8(x * scale, y * scale, strip.now / (16 - SEGMENT.speed/16));
-      SEGMENT.setPixelColorXY(x, y, ColorFromPalette(SEGPALETTE, pixelHue8));
+      SEGMENT.setPixelColorXY(x, y, ColorFromPalette(SEGPALETTE, noiseRow[x]));
     }
   }
 
@@ -5850,10 +5896,12 @@ uint16_t mode_2DSunradiation(void) {                   // By: ldirko https://edi
   unsigned long t = strip.now / 4;
   unsigned index = 0;
   uint8_t someVal = SEGMENT.speed/4;             // Was 25.
+  uint8_t noiseRow[cols + 2];
   for (int j = 0; j < (rows + 2); j++) {
+    perlin8Row(noiseRow, cols + 2, 0, someVal, j * someVal, t);
     for (int i = 0; i < (cols + 2); i++) {
       //byte col = (inoise8_raw(i * someVal, j * someVal, t)) / 2;
-      byte col = ((int16_t)perlin8(i * someVal, j * someVal, t) - 0x7F) / 3;
+      byte col = ((int16_t)noiseRow[i] - 0x7F) / 3;
       bump[index++] = col;
     }
   }
@@ -6422,16 +6470,27 @@ uint16_t mode_2Dplasmarotozoom() {
   // plasma
   for (int j = 0; j < rows; j++) {
     int index = j*cols;
-    for (int i = 0; i < cols; i++) {
-      if (SEGMENT.check1) plasma[index+i] = (i * 4 ^ j * 4) + ms / 6;
-      else                plasma[index+i] = inoise8(i * 40, j * 40, ms);
-    }
+    if (SEGMENT.check1) for (int i = 0; i < cols; i++) plasma[index+i] = (i * 4 ^ j * 4) + ms / 6;
+    else                perlin8Row(plasma + index, cols, 0, 40, j * 40, ms);
   }
 
   // rotozoom
   float f       = (sin_t(*a/2)+((128-SEGMENT.intensity)/128.0f)+1.1f)/1.5f;  // scale factor
   float kosinus = cos_t(*a) * f;
   float sinus   = sin_t(*a) * f;
+#if WLED_FX_FIXEDPOINT
+  const int32_t kosinusQ = kosinus * 65536; // Q16, |f| is below 2.1 so coordinates fit 32 bits
+  const int32_t sinusQ   = sinus * 65536;
+  for (int i = 0; i < cols; i++) {
+    int32_t u1 = i * kosinusQ;
+    int32_t v1 = i * sinusQ;
+    for (int j = 0; j < rows; j++) {
+        byte u = abs8((u1 - j * sinusQ) / 65536) % cols; // note: division truncates towards zero like the float to int conversion
+        byte v = abs8((v1 + j * kosinusQ) / 65536) % rows;
+        SEGMENT.setPixelColorXY(i, j, SEGMENT.color_from_palette(plasma[v*cols+u], false, PALETTE_SOLID_WRAP, 255));
+    }
+  }
+#else
   for (int i = 0; i < cols; i++) {
     float u1 = i * kosinus;
     float v1 = i * sinus;
@@ -6441,6 +6500,7 @@ uint16_t mode_2Dplasmarotozoom() {
         SEGMENT.setPixelColorXY(i, j, SEGMENT.color_from_palette(plasma[v*cols+u], false, PALETTE_SOLID_WRAP, 255));
     }
   }
+#endif
   *a -= 0.03f + float(SEGENV.speed-128)*0.0002f;  // rotation speed
   if(*a < -6283.18530718f) *a += 6283.18530718f; // 1000*2*PI, protect sin/cos from very large input float values (will give wrong results)
 
@@ -7768,11 +7828,13 @@ uint16_t mode_2Dsoap() {
   if (SEGENV.call == 0) for (int i = 0; i < 3; i++) noisecoord[i] = hw_random(); // init
   else                  for (int i = 0; i < 3; i++) noisecoord[i] += mov;
 
-  for (int i = 0; i < cols; i++) {
-    int32_t ioffset = scale32_x * (i - cols / 2);
-    for (int j = 0; j < rows; j++) {
-      int32_t joffset = scale32_y * (j - rows / 2);
-      uint8_t data = perlin16(noisecoord[0] + ioffset, noisecoord[1] + joffset, noisecoord[2]) >> 8;
+  uint16_t noiseRow[cols];
+  const int32_t ioffset = scale32_x * (0 - cols / 2); // offset of first column
+  for (int j = 0; j < rows; j++) {
+    int32_t joffset = scale32_y * (j - rows / 2);
+    perlin16Row(noiseRow, cols, noisecoord[0] + ioffset, scale32_x, noisecoord[1] + joffset, noisecoord[2]);
+    for (int i = 0; i < cols; i++) {
+      uint8_t data = noiseRow[i] >> 8;
       noise3d[XY(i,j)] = scale8(noise3d[XY(i,j)], smoothness) + scale8(data, 255 - smoothness);
     }
   }
@@ -7917,6 +7979,7 @@ uint16_t mode_particlevortex(void) {
     return mode_static(); // something went wrong, no data!
 
   PartSys->updateSystem(); // update system properties (dimensions and data pointers)
+  PartSys->applyQualityLevel(); // use fewer particles if effects are too slow (adaptive quality)
   uint32_t spraycount = min(PartSys->numSources, (uint32_t)(1 + (SEGMENT.custom1 >> 5))); // number of sprays to display, 1-8
   #ifdef ESP8266
   for (i = 1; i < 4; i++) { // need static particles in the center to reduce blinking (would be black every other frame without this hack), just set them there fixed
@@ -8026,6 +8089,7 @@ uint16_t mode_particlefireworks(void) {
     return mode_static(); // something went wrong, no data!
 
   PartSys->updateSystem(); // update system properties (dimensions and data pointers)
+  PartSys->applyQualityLevel(); // use fewer particles if effects are too slow (adaptive quality)
   numRockets = map(SEGMENT.speed, 0 , 255, 4, min(PartSys->numSources, (uint32_t)NUMBEROFSOURCES));
 
   PartSys->setWrapX(SEGMENT.check1);
@@ -8199,6 +8263,7 @@ uint16_t mode_particlevolcano(void) {
 
   // Particle System settings
   PartSys->updateSystem(); // update system properties (dimensions and data pointers)
+  PartSys->applyQualityLevel(); // use fewer particles if effects are too slow (adaptive quality)
   PartSys->setColorByAge(SEGMENT.check1);
   PartSys->setBounceX(SEGMENT.check2);
   PartSys->setWallHardness(SEGMENT.custom2);
@@ -8236,6 +8301,7 @@ uint16_t mode_particlefire(void) {
     return mode_static(); // something went wrong, no data!
 
   PartSys->updateSystem(); // update system properties (dimensions and data pointers)
+  PartSys->applyQualityLevel(); // use fewer particles if effects are too slow (adaptive quality)
   PartSys->setWrapX(SEGMENT.check2);
   PartSys->setMotionBlur(SEGMENT.check1 * 170); // anable/disable motion blur
   PartSys->setSmearBlur(!SEGMENT.check1 * 60);  // enable smear blur if motion blur is not enabled
@@ -8429,6 +8495,7 @@ uint16_t mode_particlewaterfall(void) {
 
   // Particle System settings
   PartSys->updateSystem(); // update system properties (dimensions and data pointers)
+  PartSys->applyQualityLevel(); // use fewer particles if effects are too slow (adaptive quality)
   PartSys->setWrapX(SEGMENT.check1);   // cylinder
   PartSys->setBounceX(SEGMENT.check2); // walls
   PartSys->setBounceY(SEGMENT.check3); // ground
@@ -8639,6 +8706,7 @@ uint16_t mode_particleimpact(void) {
 
   // Particle System settings
   PartSys->updateSystem(); // update system properties (dimensions and data pointers)
+  PartSys->applyQualityLevel(); // use fewer particles if effects are too slow (adaptive quality)
   PartSys->setWrapX(SEGMENT.check1);
   PartSys->setBounceX(SEGMENT.check2);
   PartSys->setMotionBlur(SEGMENT.custom3<<3);
@@ -8840,6 +8908,7 @@ uint16_t mode_particlespray(void) {
 
   // Particle System settings
   PartSys->updateSystem(); // update system properties (dimensions and data pointers)
+  PartSys->applyQualityLevel(); // use fewer particles if effects are too slow (adaptive quality)
   PartSys->setBounceX(!SEGMENT.check2);
   PartSys->setWrapX(SEGMENT.check2);
   PartSys->setWallHardness(hardness);
@@ -9979,6 +10048,7 @@ uint16_t mode_particle1Dspray(void) {
 
   // Particle System settings
   PartSys->updateSystem(); // update system properties (dimensions and data pointers)
+  PartSys->applyQualityLevel(); // use fewer particles if effects are too slow (adaptive quality)
   PartSys->setBounce(SEGMENT.check2);
   PartSys->setMotionBlur(SEGMENT.custom2); // anable motion blur
   int32_t gravity = -((int32_t)SEGMENT.custom3 - 16);  // gravity setting, 0-15 is positive (down), 17 - 31 is negative (up)
@@ -10340,6 +10410,7 @@ uint16_t mode_particleFire1D(void) {
 
   // Particle System settings
   PartSys->updateSystem(); // update system properties (dimensions and data pointers)
+  PartSys->applyQualityLevel(); // use fewer particles if effects are too slow (adaptive quality)
   PartSys->setMotionBlur(128 + (SEGMENT.custom2 >> 1)); // enable motion blur
   PartSys->setColorByAge(true);
   uint32_t emitparticles = 1;
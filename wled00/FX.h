@@ -79,6 +79,20 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #endif
 #define FPS_UNLIMITED    0
 
+// adaptive quality: level effects scale their workload to (255 = full quality, QUALITY_LEVEL_MIN lowest)
+#include "quality.h"
+#define QUALITY_LEVEL        strip.getQualityLevel()
+
+// use fixed point pixel kernels in float heavy 2D effects (Julia, Rotozoomer), default on chips without FPU
+// (64 bit products of the Julia kernel are library calls on ESP8266 but still far cheaper than software floats, see tools/fx_fixedpoint_test.cpp)
+#ifndef WLED_FX_FIXEDPOINT
+  #if defined(ESP8266) || defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32S2)
+    #define WLED_FX_FIXEDPOINT 1
+  #else
+    #define WLED_FX_FIXEDPOINT 0
+  #endif
+#endif
+
 // FPS calculation (can be defined as compile flag for debugging)
 #ifndef FPS_CALC_AVG
 #define FPS_CALC_AVG 7 // average FPS calculation over this many frames (moving average)
@@ -538,6 +552,7 @@ class Segment {
   protected:
 
     inline static void     addUsedSegmentData(int len)     { Segment::_usedSegmentData += len; }
+    [[gnu::hot]] static void blurLine(uint32_t *line, unsigned length, uint8_t keep, uint8_t seep); // in-place 1D blur of consecutive pixels
 
     inline uint32_t *getPixels() const                              { return pixels; }
     inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { pixels[i] = c; }
@@ -763,7 +778,7 @@ class Segment {
     inline void fadePixelColorXY(uint16_t x, uint16_t y, uint8_t fade) const                   { setPixelColorXY(x, y, color_fade(getPixelColorXY(x,y), fade, true)); }
     inline void blurCols(fract8 blur_amount, bool smear = false) const                         { blur2D(0, blur_amount, smear); } // blur all columns (50% faster than full 2D blur)
     inline void blurRows(fract8 blur_amount, bool smear = false) const                         { blur2D(blur_amount, 0, smear); } // blur all rows (50% faster than full 2D blur)
-    //void box_blur(unsigned r = 1U, bool smear = false); // 2D box blur
+    void box_blur(unsigned radius = 1U, bool smear = false) const; // 2D box blur
     void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false) const;
     void moveX(int delta, bool wrap = false) const;
     void moveY(int delta, bool wrap = false) const;
@@ -798,7 +813,7 @@ class Segment {
     inline void addPixelColorXY(int x, int y, byte r, byte g, byte b, byte w = 0, bool saturate = false) const { addPixelColor(x, RGBW32(r,g,b,w), saturate); }
     inline void addPixelColorXY(int x, int y, CRGB c, bool saturate = false) const         { addPixelColor(x, RGBW32(c.r,c.g,c.b,0), saturate); }
     inline void fadePixelColorXY(uint16_t x, uint16_t y, uint8_t fade) const               { fadePixelColor(x, fade); }
-    //inline void box_blur(unsigned i, bool vertical, fract8 blur_amount) {}
+    inline void box_blur(unsigned radius = 1U, bool smear = false) {}
     inline void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false) {}
     inline void blurCols(fract8 blur_amount, bool smear = false) { blur(blur_amount, smear); } // blur all columns (50% faster than full 2D blur)
     inline void blurRows(fract8 blur_amount, bool smear = false) {}
@@ -845,6 +860,7 @@ class WS2812FX {
 #endif
       correctWB(false),
       cctFromRgb(false),
+      adaptiveQuality(false),
       // true private variables
       _pixels(nullptr),
       _pixelCCT(nullptr),
@@ -855,6 +871,8 @@ class WS2812FX {
       _frametime(FRAMETIME_FIXED),
       _cumulativeFps(WLED_FPS << FPS_CALC_SHIFT),
       _targetFps(WLED_FPS),
+      _quality(255),
+      _effectTime(0),
       _isServicing(false),
       _isOffRefreshRequired(false),
       _hasWhiteChannel(false),
@@ -930,6 +948,7 @@ class WS2812FX {
     bool deserializeMap(unsigned n = 0);
 
     inline bool isUpdating() const           { return !BusManager::canAllShow(); } // return true if the strip is being sent pixel updates
+    inline bool isShowPending() const        { return BusManager::isShowPending(); } // return true if a frame waits to be sent (flushed by BusManager::service() at the end of loop())
     inline bool isServicing() const          { return _isServicing; }           // returns true if strip.service() is executing
     inline bool hasWhiteChannel() const      { return _hasWhiteChannel; }       // returns true if strip contains separate white chanel
     inline bool isOffRefreshRequired() const { return _isOffRefreshRequired; }  // returns true if strip requires regular updates (i.e. TM1814 chipset)
@@ -949,6 +968,7 @@ class WS2812FX {
     inline uint8_t getCurrSegmentId() const { return _segment_index; }    // returns current segment index (only valid while strip.isServicing())
     inline uint8_t getMainSegmentId() const { return _mainSegment; }      // returns main segment index
     inline uint8_t getTargetFps() const     { return _targetFps; }        // returns rough FPS value for las 2s interval
+    inline uint8_t getQualityLevel() const  { return adaptiveQuality ? _quality : 255; } // returns effect quality level (255 = full quality, lowered if effects exceed frame time)
     inline uint8_t getModeCount() const     { return _modeCount; }        // returns number of registered modes/effects
 
     uint16_t getLengthPhysical() const;
@@ -1015,9 +1035,10 @@ class WS2812FX {
 
     bool isMatrix;
     struct {
-      bool autoSegments : 1;
-      bool correctWB    : 1;
-      bool cctFromRgb   : 1;
+      bool autoSegments    : 1;
+      bool correctWB       : 1;
+      bool cctFromRgb      : 1;
+      bool adaptiveQuality : 1;
     };
 
     Segment *_currentSegment;
@@ -1036,6 +1057,8 @@ class WS2812FX {
     uint16_t _frametime;
     uint16_t _cumulativeFps;
     uint8_t  _targetFps;
+    uint8_t  _quality;    // adaptive quality level
+    uint32_t _effectTime; // smoothed time spent in effect functions per frame (in us)
 
     // will require only 1 byte
     struct {
@@ -240,125 +240,38 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColorXY(int x, int y) const {
 }
 
 // 2D blurring, can be asymmetrical
+// both passes walk the pixel buffer row by row (cache friendly, pixel buffer may be in PSRAM)
 void Segment::blur2D(uint8_t blur_x, uint8_t blur_y, bool smear) const {
   if (!isActive()) return; // not active
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  const auto XY = [&](unsigned x, unsigned y){ return x + y*cols; };
+  uint32_t *pxls = getPixels();
   if (blur_x) {
     const uint8_t keepx = smear ? 255 : 255 - blur_x;
     const uint8_t seepx = blur_x >> 1;
-    for (unsigned row = 0; row < rows; row++) { // blur rows (x direction)
-      // handle first pixel in row to avoid conditional in loop (faster)
-      uint32_t cur = getPixelColorRaw(XY(0, row));
-      uint32_t carryover = fast_color_scale(cur, seepx);
-      setPixelColorRaw(XY(0, row), fast_color_scale(cur, keepx));
-      for (unsigned x = 1; x < cols; x++) {
-         cur = getPixelColorRaw(XY(x, row));
-        uint32_t part = fast_color_scale(cur, seepx);
-        cur = fast_color_scale(cur, keepx);
-        cur = color_add(cur, carryover);
-        setPixelColorRaw(XY(x - 1, row), color_add(getPixelColorRaw(XY(x-1, row)), part)); // previous pixel
-        setPixelColorRaw(XY(x, row), cur); // current pixel
-        carryover = part;
-      }
-    }
+    for (unsigned row = 0; row < rows; row++) blurLine(pxls + row * cols, cols, keepx, seepx); // blur rows (x direction)
   }
   if (blur_y) {
     const uint8_t keepy = smear ? 255 : 255 - blur_y;
     const uint8_t seepy = blur_y >> 1;
-    for (unsigned col = 0; col < cols; col++) {
-      // handle first pixel in column
-      uint32_t cur = getPixelColorRaw(XY(col, 0));
-      uint32_t carryover = fast_color_scale(cur, seepy);
-      setPixelColorRaw(XY(col, 0), fast_color_scale(cur, keepy));
-      for (unsigned y = 1; y < rows; y++) {
-        cur = getPixelColorRaw(XY(col, y));
-        uint32_t part = fast_color_scale(cur, seepy);
-        cur = fast_color_scale(cur, keepy);
-        cur = color_add(cur, carryover);
-        setPixelColorRaw(XY(col, y - 1), color_add(getPixelColorRaw(XY(col, y-1)), part)); // previous pixel
-        setPixelColorRaw(XY(col, y), cur); // current pixel
-        carryover = part;
-      }
-    }
+    uint32_t carryover[cols]; // part of the row above seeping into the current row, one entry per column
+    blurPixelColumns(pxls, cols, rows, keepy, seepy, carryover); // blur columns (y direction)
   }
 }
 
-/*
-// 2D Box blur
-void Segment::box_blur(unsigned radius, bool smear) {
+// 2D box blur (averages pixels in a (2*radius+1)^2 window), separable: running window sums on rows, then on columns
+// if smear is set pixels do not get darker
+void Segment::box_blur(unsigned radius, bool smear) const {
   if (!isActive() || radius == 0) return; // not active
   if (radius > 3) radius = 3;
-  const unsigned d = (1 + 2*radius) * (1 + 2*radius); // averaging divisor
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  uint16_t *tmpRSum = new uint16_t[cols*rows];
-  uint16_t *tmpGSum = new uint16_t[cols*rows];
-  uint16_t *tmpBSum = new uint16_t[cols*rows];
-  uint16_t *tmpWSum = new uint16_t[cols*rows];
-  // fill summed-area table (https://en.wikipedia.org/wiki/Summed-area_table)
-  for (unsigned x = 0; x < cols; x++) {
-    unsigned rS, gS, bS, wS;
-    unsigned index;
-    rS = gS = bS = wS = 0;
-    for (unsigned y = 0; y < rows; y++) {
-      index = x * cols + y;
-      if (x > 0) {
-        unsigned index2 = (x - 1) * cols + y;
-        tmpRSum[index] = tmpRSum[index2];
-        tmpGSum[index] = tmpGSum[index2];
-        tmpBSum[index] = tmpBSum[index2];
-        tmpWSum[index] = tmpWSum[index2];
-      } else {
-        tmpRSum[index] = 0;
-        tmpGSum[index] = 0;
-        tmpBSum[index] = 0;
-        tmpWSum[index] = 0;
-      }
-      uint32_t c = getPixelColorXY(x, y);
-      rS += R(c);
-      gS += G(c);
-      bS += B(c);
-      wS += W(c);
-      tmpRSum[index] += rS;
-      tmpGSum[index] += gS;
-      tmpBSum[index] += bS;
-      tmpWSum[index] += wS;
-    }
-  }
-  // do a box blur using pre-calculated sums
-  for (unsigned x = 0; x < cols; x++) {
-    for (unsigned y = 0; y < rows; y++) {
-      // sum = D + A - B - C where k = (x,y)
-      // +----+-+---- (x)
-      // |    | |
-      // +----A-B
-      // |    |k|
-      // +----C-D
-      // |
-      //(y)
-      unsigned x0 = x < radius ? 0 : x - radius;
-      unsigned y0 = y < radius ? 0 : y - radius;
-      unsigned x1 = x >= cols - radius ? cols - 1 : x + radius;
-      unsigned y1 = y >= rows - radius ? rows - 1 : y + radius;
-      unsigned A = x0 * cols + y0;
-      unsigned B = x1 * cols + y0;
-      unsigned C = x0 * cols + y1;
-      unsigned D = x1 * cols + y1;
-      unsigned r = tmpRSum[D] + tmpRSum[A] - tmpRSum[C] - tmpRSum[B];
-      unsigned g = tmpGSum[D] + tmpGSum[A] - tmpGSum[C] - tmpGSum[B];
-      unsigned b = tmpBSum[D] + tmpBSum[A] - tmpBSum[C] - tmpBSum[B];
-      unsigned w = tmpWSum[D] + tmpWSum[A] - tmpWSum[C] - tmpWSum[B];
-      setPixelColorXY(x, y, RGBW32(r/d, g/d, b/d, w/d));
-    }
-  }
-  delete[] tmpRSum;
-  delete[] tmpGSum;
-  delete[] tmpBSum;
-  delete[] tmpWSum;
+  uint32_t *pxls = getPixels();
+  uint32_t line[std::max(cols, rows)]; // unmodified copy of the row or column being blurred
+  for (unsigned y = 0; y < rows; y++) boxBlurPixelLine(pxls + y * cols, cols, 1, radius, smear, line); // rows (consecutive pixels)
+  for (unsigned x = 0; x < cols; x++) boxBlurPixelLine(pxls + x, rows, cols, radius, smear, line);     // columns
 }
-*/
+
 void Segment::moveX(int delta, bool wrap) const {
   if (!isActive() || !delta) return; // not active
   const int vW = vWidth();   // segment width in logical pixels (can be 0 if segment is inactive)
@@ -1064,6 +1064,11 @@ void Segment::fadeToBlackBy(uint8_t fadeBy) const {
   for (unsigned i = 0; i < rlength; i++) setPixelColorRaw(i, fast_color_scale(getPixelColorRaw(i), 255-fadeBy));
 }
 
+// in-place blur of consecutive pixels (see blurPixelLine() in pixel_blur.h)
+void WLED_O2_ATTR Segment::blurLine(uint32_t *line, unsigned length, uint8_t keep, uint8_t seep) {
+  blurPixelLine(line, length, keep, seep);
+}
+
 /*
  * blurs segment content, source: FastLED colorutils.cpp
  * Note: for blur_amount > 215 this function does not work properly (creates alternating pattern)
@@ -1078,22 +1083,7 @@ void Segment::blur(uint8_t blur_amount, bool smear) const {
     return;
   }
 #endif
-  uint8_t keep = smear ? 255 : 255 - blur_amount;
-  uint8_t seep = blur_amount >> 1;
-  unsigned vlength = vLength();
-  // handle first pixel to avoid conditional in loop (faster)
-  uint32_t cur = getPixelColorRaw(0);
-  uint32_t carryover = fast_color_scale(cur, seep);
-  setPixelColorRaw(0, fast_color_scale(cur, keep));
-  for (unsigned i = 1; i < vlength; i++) {
-    cur = getPixelColorRaw(i);
-    uint32_t part = fast_color_scale(cur, seep);
-    cur = fast_color_scale(cur, keep);
-    cur = color_add(cur, carryover);
-    setPixelColorRaw(i - 1, color_add(getPixelColorRaw(i - 1), part)); // previous pixel
-    setPixelColorRaw(i, cur); // current pixel
-    carryover = part;
-  }
+  blurLine(getPixels(), vLength(), smear ? 255 : 255 - blur_amount, blur_amount >> 1);
 }
 
 /*
@@ -1177,9 +1167,12 @@ void WS2812FX::finalizeInit() {
     }
   }
   DEBUG_PRINTF_P(PSTR("Maximum LEDs on a bus: %u\nDigital buses: %u\n"), maxLedsOnBus, digitalCount);
-  // we may remove 600 LEDs per bus limit when NeoPixelBus is updated beyond 2.8.3
-  if (maxLedsOnBus <= 600 && useParallelI2S) BusManager::useParallelOutput(); // must call before creating buses
-  else useParallelI2S = false; // enforce single I2S
+  // limit can be raised (WLED_MAX_LEDS_PER_PARALLEL_BUS) when NeoPixelBus is updated beyond 2.8.3
+  if (maxLedsOnBus <= WLED_MAX_LEDS_PER_PARALLEL_BUS && useParallelI2S) BusManager::useParallelOutput(); // must call before creating buses
+  else {
+    if (useParallelI2S) DEBUG_PRINTF_P(PSTR("Bus with %u LEDs exceeds parallel I2S limit (%u). Forcing single I2S output.\n"), maxLedsOnBus, WLED_MAX_LEDS_PER_PARALLEL_BUS);
+    useParallelI2S = false; // enforce single I2S
+  }
   digitalCount = 0;
   #endif
 
@@ -1200,12 +1193,7 @@ void WS2812FX::finalizeInit() {
     const bool usesI2S = false;
       #endif
     if (Bus::isDigital(bus.type) && !Bus::is2Pin(bus.type) && usesI2S) {
-      #ifdef NPB_CONF_4STEP_CADENCE
-      constexpr unsigned stepFactor = 4; // 4 step cadence (4 bits per pixel bit)
-      #else
-      constexpr unsigned stepFactor = 3; // 3 step cadence (3 bits per pixel bit)
-      #endif
-      unsigned i2sCommonSize = stepFactor * bus.count * (3*Bus::hasRGB(bus.type)+Bus::hasWhite(bus.type)+Bus::hasCCT(bus.type)) * (Bus::is16bit(bus.type)+1);
+      unsigned i2sCommonSize = BusManager::i2sMemUsage(bus.count + bus.skipAmount, Bus::getNumberOfChannels(bus.type), Bus::is16bit(bus.type));
       if (i2sCommonSize > maxI2S) maxI2S = i2sCommonSize;
     }
     #endif
@@ -1266,6 +1254,7 @@ void WS2812FX::service() {
   }
 
   bool doShow = false;
+  unsigned long effectTime = 0; // time spent in effect functions (us)
 
   _isServicing = true;
   _segment_index = 0;
@@ -1287,6 +1276,7 @@ void WS2812FX::service() {
       unsigned frameDelay = FRAMETIME;
 
       if (!seg.freeze) { //only run effect function if not frozen
+        unsigned long effectStart = micros();
         // Effect blending
         uint16_t prog = seg.progress();
         seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
@@ -1308,17 +1298,25 @@ void WS2812FX::service() {
           Segment::modeBlend(false);        // unset semaphore
         }
         if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
+        effectTime += micros() - effectStart;
       }
 
       seg.next_time = nowUp + frameDelay;
     }
     _segment_index++;
   }
+  #if !(defined(WLED_DISABLE_PARTICLESYSTEM2D) && defined(WLED_DISABLE_PARTICLESYSTEM1D))
+  if (doShow) servicePSmem(); // release particle system buffers after the last particle system effect ended
+  #endif
 
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
   #endif
   if (doShow && !_suspend) {
+    if (adaptiveQuality && _targetFps != FPS_UNLIMITED) {
+      _quality = updateQualityLevel(_quality, _effectTime, effectTime, _frametime); // see quality.h
+    } else
+      _quality = 255;
     yield();
     Segment::handleRandomPalette(); // slowly transition random palette; move it into for loop when each segment has individual random palette
     _lastServiceShow = nowUp; // update timestamp, for precise FPS control
@@ -1623,10 +1621,17 @@ void WS2812FX::show() {
   show_callback callback = _callback;
   if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
 
+  // enable temporal dithering only if we achieve sufficient FPS and keep up with target (also advances dithering frame)
+  Bus::setDitherFps(_cumulativeFps >> FPS_CALC_SHIFT, _targetFps);
+
   // paint actual pixels
+  BusManager::traceEvent(BUS_TRACE_ENCODE_START);
   int oldCCT = Bus::getCCT(); // store original CCT value (since it is global)
   // when cctFromRgb is true we implicitly calculate WW and CW from RGB values (cct==-1)
   if (cctFromRgb) BusManager::setSegmentCCT(-1);
+  #ifdef WLED_USE_16BIT_OUTPUT
+  const bool use16bit = BusManager::has16bitBus(); // apply gamma at 16 bit precision if there is a bus that can use it
+  #endif
   for (size_t i = 0; i < totalLen; i++) {
     // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
     // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
@@ -1635,11 +1640,19 @@ void WS2812FX::show() {
     }
 
     uint32_t c = _pixels[i]; // need a copy, do not modify _pixels directly (no byte access allowed on ESP32)
+    #ifdef WLED_USE_16BIT_OUTPUT
+    if (use16bit) {
+      uint64_t c64 = (c > 0 && !(realtimeMode && arlsDisableGammaCorrection)) ? gamma64(c) : RGBW64(R(c)*257, G(c)*257, B(c)*257, W(c)*257);
+      BusManager::setPixelColor64(getMappedPixelIndex(i), c64);
+      continue;
+    }
+    #endif
     if(c > 0 && !(realtimeMode && arlsDisableGammaCorrection))
         c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
     BusManager::setPixelColor(getMappedPixelIndex(i), c);
   }
   Bus::setCCT(oldCCT);  // restore old CCT for ABL adjustments
+  BusManager::traceEvent(BUS_TRACE_ENCODE_END);
 
   p_free(_pixelCCT);
   _pixelCCT = nullptr;
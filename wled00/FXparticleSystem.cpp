@@ -15,9 +15,14 @@
 #if !(defined(WLED_DISABLE_PARTICLESYSTEM2D) && defined(WLED_DISABLE_PARTICLESYSTEM1D)) // not both disabled
 #include "FXparticleSystem.h"
 // local shared functions (used both in 1D and 2D system)
-static int32_t calcForce_dv(const int8_t force, uint8_t &counter);
-static bool checkBoundsAndWrap(int32_t &position, const int32_t max, const int32_t particleradius, const bool wrap); // returns false if out of bounds by more than particleradius
 static uint32_t fast_color_scaleAdd(const uint32_t c1, const uint32_t c2, uint8_t scale = 255); // fast and accurate color adding with scaling (scales c2 before adding)
+static void resetColorCache(const TBlendType blend); // must be called once per frame before using the cached color functions
+static uint32_t cachedPaletteColor(const uint8_t index); // palette color of the current segment
+static uint32_t cachedSaturatedColor(const uint8_t index, const uint8_t sat); // palette color with limited saturation
+static uint32_t particleMemoryBudget(); // segment data bytes the current segment may use for its particle system
+static uint32_t limitParticlesToBudget(uint32_t numparticles, const uint32_t fixedmemory, const uint32_t particlememory, const uint32_t minparticles);
+static void setParticleCount(const uint32_t numparticles); // record number of particles of current segment for reporting
+static uint32_t psIdleFrames = 0; // frames since a particle system used the shared buffers (see servicePSmem())
 #endif
 
 #ifndef WLED_DISABLE_PARTICLESYSTEM2D
@@ -37,7 +42,6 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
   motionBlur = 0; //no fading by default
   smearBlur = 0; //no smearing by default
   emitIndex = 0;
-  collisionStartIdx = 0;
 
   //initialize some default non-zero values most FX use
   for (uint32_t i = 0; i < numParticles; i++) {
@@ -71,8 +75,12 @@ void ParticleSystem2D::update(void) {
     handleCollisions();
 
   //move all particles
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    particleMoveUpdate(particles[i], particleFlags[i], nullptr, advPartProps ? &advPartProps[i] : nullptr); // note: splitting this into two loops is slower and uses more flash
+  if (advPartProps == nullptr)
+    moveParticles(); // common case: all particles share the system settings
+  else {
+    for (uint32_t i = 0; i < usedParticles; i++) {
+      particleMoveUpdate(particles[i], particleFlags[i], nullptr, &advPartProps[i]); // note: splitting this into two loops is slower and uses more flash
+    }
   }
 
   render();
@@ -95,6 +103,14 @@ void ParticleSystem2D::setUsedParticles(uint8_t percentage) {
   PSPRINTLN(usedParticles);
 }
 
+// scale number of used particles to the adaptive quality level, particles that are no longer used are killed so they do not reappear mid-flight
+void ParticleSystem2D::applyQualityLevel() {
+  uint32_t scaledParticles = max((numParticles * (QUALITY_LEVEL + 1)) >> 8, (uint32_t)1);
+  for (uint32_t i = scaledParticles; i < usedParticles; i++)
+    particles[i].ttl = 0;
+  usedParticles = scaledParticles;
+}
+
 void ParticleSystem2D::setWallHardness(uint8_t hardness) {
   wallHardness = hardness;
 }
@@ -277,6 +293,26 @@ void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &par
   }
 }
 
+// batched version of particleMoveUpdate() for systems without advanced particle properties
+// settings and limits are read once instead of per particle, results are identical to calling particleMoveUpdate() on each particle
+void ParticleSystem2D::moveParticles() {
+  PSMoveSettings settings;
+  settings.maxX = maxX;
+  settings.maxY = maxY;
+  settings.hardRadius = particleHardRadius;
+  settings.renderRadius = PS_P_HALFRADIUS;
+  settings.colorByAge = particlesettings.colorByAge;
+  settings.bounceX = particlesettings.bounceX;
+  settings.bounceY = particlesettings.bounceY;
+  settings.wrapX = particlesettings.wrapX;
+  settings.wrapY = particlesettings.wrapY;
+  settings.killoutofbounds = particlesettings.killoutofbounds;
+  settings.useGravity = particlesettings.useGravity;
+  psMoveParticles(particles, particleFlags, usedParticles, settings, [this](int8_t &incoming, int8_t &parallel, int32_t &position, int32_t maxposition) {
+    bounce(incoming, parallel, position, maxposition);
+  });
+}
+
 // move function for fire particles
 void ParticleSystem2D::fireParticleupdate() {
   for (uint32_t i = 0; i < usedParticles; i++) {
@@ -434,14 +470,16 @@ void ParticleSystem2D::applyForce(const uint32_t particleindex, const int8_t xfo
 // apply a force in x,y direction to all particles
 // force is in 3.4 fixed point notation (see above)
 void ParticleSystem2D::applyForce(const int8_t xforce, const int8_t yforce) {
-  // for small forces, need to use a delay counter
-  uint8_t tempcounter;
-  // note: this is not the most computationally efficient way to do this, but it saves on duplicate code and is fast enough
+  // all particles share the system counter, so the velocity change is the same for every particle: calculate it once
+  uint8_t xcounter = forcecounter & 0x0F; // lower four bits
+  uint8_t ycounter = forcecounter >> 4;   // upper four bits
+  int32_t dvx = calcForce_dv(xforce, xcounter);
+  int32_t dvy = calcForce_dv(yforce, ycounter);
+  forcecounter = (xcounter & 0x0F) | ((ycounter << 4) & 0xF0); // save counter values back
   for (uint32_t i = 0; i < usedParticles; i++) {
-    tempcounter = forcecounter;
-    applyForce(particles[i], xforce, yforce, tempcounter);
+    particles[i].vx = limitSpeed((int32_t)particles[i].vx + dvx);
+    particles[i].vy = limitSpeed((int32_t)particles[i].vy + dvy);
   }
-  forcecounter = tempcounter; // save value back
 }
 
 // apply a force in angular direction to single particle
@@ -551,6 +589,31 @@ void ParticleSystem2D::pointAttractor(const uint32_t particleindex, PSparticle &
   applyForce(particleindex, xforce, yforce);
 }
 
+// scratch memory for sorting particles into grid cells or tiles: cell start indices followed by particle indices sorted by cell
+// particle systems are updated one after another so all segments share it, it is only (re)allocated if it needs to grow
+// and released by servicePSmem() when no particle system is running
+static uint16_t *sortScratch = nullptr;
+static uint32_t sortScratchSize = 0; // number of entries
+
+static uint16_t *getSortScratch(const uint32_t numCells, const uint32_t numParticles) {
+  const uint32_t entries = numCells + 1 + numParticles;
+  psIdleFrames = 0;
+  if (entries > sortScratchSize) {
+    d_free(sortScratch);
+    sortScratchSize = entries;
+    sortScratch = static_cast<uint16_t *>(d_malloc(sortScratchSize * sizeof(uint16_t)));
+    if (!sortScratch)
+      sortScratchSize = 0;
+  }
+  return sortScratch;
+}
+
+static void freeSortScratch() {
+  d_free(sortScratch);
+  sortScratch = nullptr;
+  sortScratchSize = 0;
+}
+
 // render particles to the LED buffer (uses palette to render the 8bit particle color value)
 // if wrap is set, particles half out of bounds are rendered to the other side of the matrix
 // warning: do not render out of bounds particles or system will crash! rendering does not check if particle is out of bounds
@@ -580,25 +643,44 @@ void ParticleSystem2D::render() {
     memset(framebuffer, 0, (maxXpixel+1) * (maxYpixel+1) * sizeof(CRGBW));
   }
 
+  // on large matrices, sort particles by screen tile (counting sort) so framebuffer writes stay local, otherwise render in particle order
+  uint16_t *renderOrder = nullptr;
+  uint32_t renderCount = usedParticles;
+  const uint32_t numPixels = (maxXpixel + 1) * (maxYpixel + 1);
+  if (PS_RENDER_BINNING_MINPIXELS && numPixels >= PS_RENDER_BINNING_MINPIXELS) {
+    uint32_t tilesW, tilesH;
+    const uint32_t tileShift = psGridSize(maxX, maxY, PS_P_RADIUS_SHIFT + PS_RENDER_TILESHIFT, PS_COLLISION_MAXCELLS, tilesW, tilesH); // huge matrix: use bigger tiles
+    const uint32_t numTiles = tilesW * tilesH;
+    uint16_t *tileStart = getSortScratch(numTiles, usedParticles);
+    if (tileStart) {
+      renderOrder = tileStart + numTiles + 1;
+      renderCount = psGridSort(tileStart, renderOrder, numTiles, usedParticles, [&](uint32_t i) -> uint32_t {
+        if (particles[i].ttl == 0 || particleFlags[i].outofbounds) return PS_GRID_SKIP;
+        int32_t px = constrain((int32_t)particles[i].x, (int32_t)0, maxX); // particles near the edge can be slightly outside the frame, clamp them to border tiles
+        int32_t py = constrain((int32_t)particles[i].y, (int32_t)0, maxY);
+        return (py >> tileShift) * tilesW + (px >> tileShift);
+      });
+    }
+  }
+
   // go over particles and render them to the buffer
-  for (uint32_t i = 0; i < usedParticles; i++) {
+  resetColorCache(fireIntesity ? LINEARBLEND_NOWRAP : blend);
+  for (uint32_t n = 0; n < renderCount; n++) {
+    const uint32_t i = renderOrder ? renderOrder[n] : n;
     if (particles[i].ttl == 0 || particleFlags[i].outofbounds)
       continue;
     // generate RGB values for particle
     if (fireIntesity) { // fire mode
       brightness = (uint32_t)particles[i].ttl * (3 + (fireIntesity >> 5)) + 5;
       brightness = min(brightness, (uint32_t)255);
-      baseRGB = ColorFromPaletteWLED(SEGPALETTE, brightness, 255, LINEARBLEND_NOWRAP);
+      baseRGB = cachedPaletteColor(brightness);
     }
     else {
       brightness = min((particles[i].ttl << 1), (int)255);
-      baseRGB = ColorFromPaletteWLED(SEGPALETTE, particles[i].hue, 255, blend);
-      if (particles[i].sat < 255) {
-        CHSV32 baseHSV;
-        rgb2hsv(baseRGB.color32, baseHSV); // convert to HSV
-        baseHSV.s = min(baseHSV.s, particles[i].sat); // set the saturation but don't increase it
-        hsv2rgb(baseHSV, baseRGB.color32); // convert back to RGB
-      }
+      if (particles[i].sat < 255)
+        baseRGB = cachedSaturatedColor(particles[i].hue, particles[i].sat);
+      else
+        baseRGB = cachedPaletteColor(particles[i].hue);
     }
     if(gammaCorrectCol) brightness = gamma8(brightness); // apply gamma correction, used for gamma-inverted brightness distribution
     renderParticle(i, brightness, baseRGB, particlesettings.wrapX, particlesettings.wrapY);
@@ -617,8 +699,8 @@ void ParticleSystem2D::render() {
     }
   }
 
-  // apply 2D blur to rendered frame
-  if (smearBlur) {
+  // apply 2D blur to rendered frame (skipped if effects are too slow)
+  if (smearBlur && QUALITY_LEVEL > 127) {
     blur2D(framebuffer, maxXpixel + 1, maxYpixel + 1, smearBlur, smearBlur);
   }
 }
@@ -791,67 +873,46 @@ void WLED_O2_ATTR ParticleSystem2D::renderParticle(const uint32_t particleindex,
 }
 
 // detect collisions in an array of particles and handle them
-// uses binning by dividing the frame into slices in x direction which is efficient if using gravity in y direction (but less efficient for FX that use forces in x direction)
-// for code simplicity, no y slicing is done, making very tall matrix configurations less efficient
-// note: also tested adding y slicing, it gives diminishing returns, some FX even get slower. FX not using gravity would benefit with a 10% FPS improvement
+// particles are sorted into a uniform grid (counting sort) using their lookahead position, cell size is at least the collision distance
+// so only the particle's own cell and half of its neighbours need to be checked, every colliding pair is found in every frame
 void ParticleSystem2D::handleCollisions() {
-  uint32_t collDistSq = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
-  collDistSq = collDistSq * collDistSq; // square it for faster comparison (square is one operation)
-  // note: partices are binned in x-axis, assumption is that no more than half of the particles are in the same bin
-  // if they are, collisionStartIdx is increased so each particle collides at least every second frame (which still gives decent collisions)
-  constexpr int BIN_WIDTH = 6 * PS_P_RADIUS; // width of a bin in sub-pixels
-  int32_t overlap = particleHardRadius << 1; // overlap bins to include edge particles to neighbouring bins
-  if (advPartProps) //may be using individual particle size
-    overlap += 512; // add 2 * max radius (approximately)
-  uint32_t maxBinParticles = max((uint32_t)50, (usedParticles + 1) / 2); // assume no more than half of the particles are in the same bin, do not bin small amounts of particles
-  uint32_t numBins = (maxX + (BIN_WIDTH - 1)) / BIN_WIDTH; // number of bins in x direction
-  uint16_t binIndices[maxBinParticles]; // creat array on stack for indices, 2kB max for 1024 particles (ESP32_MAXPARTICLES/2)
-  uint32_t binParticleCount; // number of particles in the current bin
-  uint16_t nextFrameStartIdx = hw_random16(usedParticles); // index of the first particle in the next frame (set to fixed value if bin overflow)
-  uint32_t pidx = collisionStartIdx; //start index in case a bin is full, process remaining particles next frame
+  if (advPartProps) setParticleSize(particlesize); // particleMoveUpdate() leaves particleHardRadius set to the last particle's individual size
+  const uint32_t baseDist = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
+  uint32_t collDistSq = baseDist * baseDist; // square it for faster comparison (square is one operation)
+  uint32_t maxDist = baseDist + (advPartProps ? 255 : 0); // individual particle sizes add up to (255+255)/2
+  uint32_t cellShift = PS_P_RADIUS_SHIFT;
+  while ((1U << cellShift) < maxDist) cellShift++;
+  uint32_t gridW, gridH;
+  cellShift = psGridSize(maxX, maxY, cellShift, PS_COLLISION_MAXCELLS, gridW, gridH); // large matrix: use bigger cells
+  const uint32_t numCells = gridW * gridH;
+
+  uint16_t *cellStart = getSortScratch(numCells, usedParticles); // numCells + 1 entries
+  if (!cellStart) {
+    PSPRINTLN(F("PS collision grid alloc failed"));
+    return;
+  }
+  uint16_t *sorted = cellStart + numCells + 1;
 
-  // fill the binIndices array for this bin
-  for (uint32_t bin = 0; bin < numBins; bin++) {
-    binParticleCount = 0; // reset for this bin
-    int32_t binStart = bin * BIN_WIDTH - overlap; // note: first bin will extend to negative, but that is ok as out of bounds particles are ignored
-    int32_t binEnd = binStart + BIN_WIDTH + overlap; // note: last bin can be out of bounds, see above;
+  // cell of a particle using its lookahead position (same position as used in collision check), out of frame positions are clamped to border cells
+  psGridSort(cellStart, sorted, numCells, usedParticles, [&](uint32_t i) -> uint32_t {
+    if (particles[i].ttl == 0 || particleFlags[i].outofbounds || !particleFlags[i].collide) return PS_GRID_SKIP;
+    int32_t px = constrain((int32_t)particles[i].x + particles[i].vx, (int32_t)0, maxX);
+    int32_t py = constrain((int32_t)particles[i].y + particles[i].vy, (int32_t)0, maxY);
+    return (py >> cellShift) * gridW + (px >> cellShift);
+  });
 
-    // fill the binIndices array for this bin
-    for (uint32_t i = 0; i < usedParticles; i++) {
-      if (particles[pidx].ttl > 0) { // is alive
-        if (particles[pidx].x >= binStart && particles[pidx].x <= binEnd) { // >= and <= to include particles on the edge of the bin (overlap to ensure boarder particles collide with adjacent bins)
-          if(particleFlags[pidx].outofbounds == 0 && particleFlags[pidx].collide) { // particle is in frame and does collide note: checking flags is quite slow and usually these are set, so faster to check here
-            if (binParticleCount >= maxBinParticles) { // bin is full, more particles in this bin so do the rest next frame
-              nextFrameStartIdx = pidx; // bin overflow can only happen once as bin size is at least half of the particles (or half +1)
-              break;
-            }
-            binIndices[binParticleCount++] = pidx;
-          }
-        }
-      }
-      pidx++;
-      if (pidx >= usedParticles) pidx = 0; // wrap around
+  psGridPairs(cellStart, sorted, gridW, gridH, [&](uint32_t idx_i, uint32_t idx_j) {
+    if (advPartProps) { //may be using individual particle size
+      collDistSq = baseDist + (((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) >> 1); // collision distance note: not 100% clear why the >> 1 is needed, but it is.
+      collDistSq = collDistSq * collDistSq; // square it for faster comparison
     }
-
-    for (uint32_t i = 0; i < binParticleCount; i++) { // go though all 'higher number' particles in this bin and see if any of those are in close proximity and if they are, make them collide
-      uint32_t idx_i = binIndices[i];
-      for (uint32_t j = i + 1; j < binParticleCount; j++) { // check against higher number particles
-        uint32_t idx_j = binIndices[j];
-        if (advPartProps) { //may be using individual particle size
-          setParticleSize(particlesize); // updates base particleHardRadius
-          collDistSq = (particleHardRadius << 1) + (((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) >> 1); // collision distance note: not 100% clear why the >> 1 is needed, but it is.
-          collDistSq = collDistSq * collDistSq; // square it for faster comparison
-        }
-        int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
-        if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
-          int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
-          if (dy * dy < collDistSq) // particles are close
-            collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq);
-        }
-      }
+    int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
+    if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
+      int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
+      if (dy * dy < collDistSq) // particles are close
+        collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq);
     }
-  }
-  collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
+  });
 }
 
 // handle a collision if close proximity is detected, i.e. dx and/or dy smaller than 2*PS_P_RADIUS
@@ -1080,9 +1141,7 @@ uint32_t calculateNumberOfSources2D(uint32_t pixels, uint32_t requestedsources)
 }
 
 //allocate memory for particle system class, particles, sprays plus additional memory requested by FX //TODO: add percentofparticles like in 1D to reduce memory footprint of some FX?
-bool allocateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources, bool isadvanced, bool sizecontrol, uint32_t additionalbytes) {
-  PSPRINTLN("PS 2D alloc");
-  PSPRINTLN("numparticles:" + String(numparticles) + " numsources:" + String(numsources) + " additionalbytes:" + String(additionalbytes));
+uint32_t particleSystemMemory2D(uint32_t numparticles, uint32_t numsources, bool isadvanced, bool sizecontrol, uint32_t additionalbytes) {
   uint32_t requiredmemory = sizeof(ParticleSystem2D);
   // functions above make sure numparticles is a multiple of 4 bytes (to avoid alignment issues)
   requiredmemory += sizeof(PSparticleFlags) * numparticles;
@@ -1093,7 +1152,13 @@ bool allocateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources,
     requiredmemory += sizeof(PSsizeControl) * numparticles;
   requiredmemory += sizeof(PSsource) * numsources;
   requiredmemory += additionalbytes;
-  return(SEGMENT.allocateData(requiredmemory));
+  return requiredmemory;
+}
+
+bool allocateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources, bool isadvanced, bool sizecontrol, uint32_t additionalbytes) {
+  PSPRINTLN("PS 2D alloc");
+  PSPRINTLN("numparticles:" + String(numparticles) + " numsources:" + String(numsources) + " additionalbytes:" + String(additionalbytes));
+  return(SEGMENT.allocateData(particleSystemMemory2D(numparticles, numsources, isadvanced, sizecontrol, additionalbytes)));
 }
 
 // initialize Particle System, allocate additional bytes if needed (pointer to those bytes can be read from particle system class: PSdataEnd)
@@ -1108,6 +1173,8 @@ bool initParticleSystem2D(ParticleSystem2D *&PartSys, uint32_t requestedsources,
   PSPRINT(" segmentsize:" + String(cols) + " x " + String(rows));
   PSPRINTLN(" request numparticles:" + String(numparticles));
   uint32_t numsources = calculateNumberOfSources2D(pixels, requestedsources);
+  uint32_t fixedmemory = particleSystemMemory2D(0, numsources, advanced, sizecontrol, additionalbytes);
+  numparticles = limitParticlesToBudget(numparticles, fixedmemory, particleSystemMemory2D(4, 0, advanced, sizecontrol, 0) - particleSystemMemory2D(0, 0, advanced, sizecontrol, 0), 4);
   bool allocsuccess = false;
   while(numparticles >= 4) { // make sure we have at least 4 particles or quit
     if (allocateParticleSystemMemory2D(numparticles, numsources, advanced, sizecontrol, additionalbytes)) {
@@ -1115,7 +1182,7 @@ bool initParticleSystem2D(ParticleSystem2D *&PartSys, uint32_t requestedsources,
       allocsuccess = true;
       break; // allocation succeeded
     }
-    numparticles = ((numparticles / 2) + 3) & ~0x03; // cut number of particles in half and try again, must be 4 byte aligned
+    numparticles = (numparticles / 2) & ~0x03; // cut number of particles in half and try again, must be 4 byte aligned (rounding down, 4 would not shrink otherwise)
     PSPRINTLN(F("PS 2D alloc failed, trying with less particles..."));
   }
   if (!allocsuccess) {
@@ -1124,6 +1191,7 @@ bool initParticleSystem2D(ParticleSystem2D *&PartSys, uint32_t requestedsources,
   }
 
   PartSys = new (SEGENV.data) ParticleSystem2D(cols, rows, numparticles, numsources, advanced, sizecontrol); // particle system constructor
+  setParticleCount(numparticles);
 
   PSPRINTLN(F("2D PS init done"));
   return true;
@@ -1199,6 +1267,14 @@ void ParticleSystem1D::setUsedParticles(const uint8_t percentage) {
   PSPRINTLN(usedParticles);
 }
 
+// scale number of used particles to the adaptive quality level, particles that are no longer used are killed so they do not reappear mid-flight
+void ParticleSystem1D::applyQualityLevel() {
+  uint32_t scaledParticles = max((numParticles * (QUALITY_LEVEL + 1)) >> 8, (uint32_t)1);
+  for (uint32_t i = scaledParticles; i < usedParticles; i++)
+    particles[i].ttl = 0;
+  usedParticles = scaledParticles;
+}
+
 void ParticleSystem1D::setWallHardness(const uint8_t hardness) {
   wallHardness = hardness;
 }
@@ -1439,22 +1515,17 @@ void ParticleSystem1D::render() {
   }
 
   // go over particles and render them to the buffer
+  resetColorCache(blend);
   for (uint32_t i = 0; i < usedParticles; i++) {
     if ( particles[i].ttl == 0 || particleFlags[i].outofbounds)
       continue;
 
     // generate RGB values for particle
     brightness = min(particles[i].ttl << 1, (int)255);
-    baseRGB = ColorFromPaletteWLED(SEGPALETTE, particles[i].hue, 255, blend);
-
-    if (advPartProps) { //saturation is advanced property in 1D system
-      if (advPartProps[i].sat < 255) {
-        CHSV32 baseHSV;
-        rgb2hsv(baseRGB.color32, baseHSV); // convert to HSV
-        baseHSV.s = min(baseHSV.s, advPartProps[i].sat); // set the saturation but don't increase it
-        hsv2rgb(baseHSV, baseRGB.color32); // convert back to RGB
-      }
-    }
+    if (advPartProps && advPartProps[i].sat < 255) //saturation is advanced property in 1D system
+      baseRGB = cachedSaturatedColor(particles[i].hue, advPartProps[i].sat);
+    else
+      baseRGB = cachedPaletteColor(particles[i].hue);
     if(gammaCorrectCol) brightness = gamma8(brightness); // apply gamma correction, used for gamma-inverted brightness distribution
     renderParticle(i, brightness, baseRGB, particlesettings.wrap);
   }
@@ -1783,7 +1854,7 @@ uint32_t calculateNumberOfSources1D(const uint32_t requestedsources) {
 }
 
 //allocate memory for particle system class, particles, sprays plus additional memory requested by FX
-bool allocateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes) {
+uint32_t particleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes) {
   uint32_t requiredmemory = sizeof(ParticleSystem1D);
   // functions above make sure these are a multiple of 4 bytes (to avoid alignment issues)
   requiredmemory += sizeof(PSparticleFlags1D) * numparticles;
@@ -1796,7 +1867,11 @@ bool allocateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t
   requiredmemory += additionalbytes;
   if (isadvanced)
     requiredmemory += sizeof(PSadvancedParticle1D) * numparticles;
-  return(SEGMENT.allocateData(requiredmemory));
+  return requiredmemory;
+}
+
+bool allocateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes) {
+  return(SEGMENT.allocateData(particleSystemMemory1D(numparticles, numsources, isadvanced, additionalbytes)));
 }
 
 // initialize Particle System, allocate additional bytes if needed (pointer to those bytes can be read from particle system class: PSdataEnd)
@@ -1805,6 +1880,8 @@ bool initParticleSystem1D(ParticleSystem1D *&PartSys, const uint32_t requestedso
   if (SEGLEN == 1) return false; // single pixel not supported
   uint32_t numparticles = calculateNumberOfParticles1D(fractionofparticles, advanced);
   uint32_t numsources = calculateNumberOfSources1D(requestedsources);
+  uint32_t fixedmemory = particleSystemMemory1D(0, numsources, advanced, additionalbytes);
+  numparticles = limitParticlesToBudget(numparticles, fixedmemory, particleSystemMemory1D(4, 0, advanced, 0) - particleSystemMemory1D(0, 0, advanced, 0), 12);
   bool allocsuccess = false;
   while(numparticles >= 10) { // make sure we have at least 10 particles or quit
     if (allocateParticleSystemMemory1D(numparticles, numsources, advanced, additionalbytes)) {
@@ -1820,6 +1897,7 @@ bool initParticleSystem1D(ParticleSystem1D *&PartSys, const uint32_t requestedso
     return false; // allocation failed
   }
   PartSys = new (SEGENV.data) ParticleSystem1D(SEGMENT.virtualLength(), numparticles, numsources, advanced); // particle system constructor
+  setParticleCount(numparticles);
   return true;
 }
 
@@ -1848,40 +1926,134 @@ void blur1D(uint32_t *colorbuffer, uint32_t size, uint32_t blur, uint32_t start)
 // Shared Utility Functions //
 //////////////////////////////
 
-// calculate the delta speed (dV) value and update the counter for force calculation (is used several times, function saves on codesize)
-// force is in 3.4 fixedpoint notation, +/-127
-static int32_t calcForce_dv(const int8_t force, uint8_t &counter) {
-  if (force == 0)
-    return 0;
-  // for small forces, need to use a delay counter
-  int32_t force_abs = abs(force); // absolute value (faster than lots of if's only 7 instructions)
-  int32_t dv = 0;
-  // for small forces, need to use a delay counter, apply force only if it overflows
-  if (force_abs < 16) {
-    counter += force_abs;
-    if (counter > 15) {
-      counter -= 16;
-      dv = force < 0 ? -1 : 1; // force is either 1 or -1 if it is small (zero force is handled above)
+// particle memory budget: without PSRAM all segments share MAX_SEGMENT_DATA, so a particle system only takes what is not used by other
+// segments, minus an equal share reserved for each particle system segment that has not allocated its memory yet (i.e. is starting up in the
+// same frame, for example when loading a preset). with more than one particle system segment each is capped to its share: a system that
+// started while it was alone (and took more) is reset once so it restarts within its share. particle counts are reduced to fit instead of
+// failing the allocation.
+static uint16_t particleCount[MAX_NUM_SEGMENTS]; // particles allocated per segment (for reporting)
+static bool particleShrunk[MAX_NUM_SEGMENTS];    // segment was reset to give up memory, it is not reset for that again
+
+static bool isParticleMode(const unsigned mode) {
+  return strncmp_P("PS ", strip.getModeData(mode), 3) == 0; // all particle system effects names start with "PS "
+}
+
+static uint32_t particleMemoryBudget() {
+  #ifdef BOARD_HAS_PSRAM
+  return UINT32_MAX; // segment data is not limited
+  #else
+  const unsigned currentId = strip.getCurrSegmentId();
+  unsigned psSegments = 1; // current segment
+  for (unsigned i = 0; i < strip.getSegmentsNum(); i++) {
+    const Segment &seg = strip.getSegment(i);
+    if (i == currentId || !seg.isActive()) continue;
+    if (isParticleMode(seg.mode)) psSegments++;
+    else if (i < MAX_NUM_SEGMENTS) particleShrunk[i] = false;
+  }
+  if (psSegments == 1 && currentId < MAX_NUM_SEGMENTS) particleShrunk[currentId] = false; // running alone
+  const uint32_t share = MAX_SEGMENT_DATA / psSegments;
+  const bool rebalance = currentId >= MAX_NUM_SEGMENTS || !particleShrunk[currentId]; // a shrunk system must not shrink others in turn
+
+  unsigned pendingSegments = 0; // other particle system segments without memory (or about to be reset)
+  bool shrinking = false;
+  const uint32_t usedNow = Segment::getUsedSegmentData() - SEGMENT.dataSize();
+  uint32_t usedByOthers = usedNow;
+  for (unsigned i = 0; i < strip.getSegmentsNum(); i++) {
+    Segment &seg = strip.getSegment(i);
+    if (i == currentId || !seg.isActive() || !isParticleMode(seg.mode)) continue;
+    if (rebalance && !seg.reset && seg.dataSize() > share && i < MAX_NUM_SEGMENTS && !particleShrunk[i]) {
+      PSPRINTLN("PS budget: reset segment " + String(i) + " to its share of " + String(share));
+      seg.markForReset(); // restarts with at most its share
+      particleShrunk[i] = true;
+      shrinking = true;
+    }
+    if (seg.dataSize() == 0 || seg.reset) {
+      pendingSegments++;
+      usedByOthers -= seg.dataSize(); // will be reallocated from its share
     }
   }
-  else
-    dv = force / 16; // MSBs, note: cannot use bitshift as dv can be negative
+  if (usedByOthers >= MAX_SEGMENT_DATA) return 0;
+  const uint32_t available = MAX_SEGMENT_DATA - usedByOthers;
+  const uint32_t reserved = pendingSegments * share;
+  uint32_t budget = available > reserved + share ? available - reserved : min(available, share);
+  if (psSegments > 1) budget = min(budget, share);
+  if (shrinking && usedNow + budget > MAX_SEGMENT_DATA) {
+    // memory of the reset segments is released once they restart: start with what is free now and restart with full share next frame
+    SEGMENT.markForReset();
+    budget = usedNow < MAX_SEGMENT_DATA ? MAX_SEGMENT_DATA - usedNow : 0;
+  }
+  return budget;
+  #endif
+}
 
-  return dv;
+// returns the number of particles (multiple of 4) that fit the budget, never less than minparticles (allocation then decides)
+static uint32_t limitParticlesToBudget(uint32_t numparticles, const uint32_t fixedmemory, const uint32_t particlememory, const uint32_t minparticles) {
+  const uint32_t budget = particleMemoryBudget();
+  const uint32_t fitting = budget > fixedmemory ? ((budget - fixedmemory) / particlememory) * 4 : 0; // particlememory is for 4 particles
+  if (fitting < numparticles) {
+    PSPRINTLN("PS budget:" + String(budget) + " limits particles to " + String(fitting));
+    numparticles = max(fitting, minparticles);
+  }
+  return numparticles;
 }
 
-// check if particle is out of bounds and wrap it around if required, returns false if out of bounds
-static bool checkBoundsAndWrap(int32_t &position, const int32_t max, const int32_t particleradius, const bool wrap) {
-  if ((uint32_t)position > (uint32_t)max) { // check if particle reached an edge, cast to uint32_t to save negative checking (max is always positive)
-    if (wrap) {
-      position = position % (max + 1); // note: cannot optimize modulo, particles can be far out of bounds when wrap is enabled
-      if (position < 0)
-        position += max + 1;
-    }
-    else if (((position < -particleradius) || (position > max + particleradius))) // particle is leaving boundaries, out of bounds if it has fully left
-      return false; // out of bounds
+static void setParticleCount(const uint32_t numparticles) {
+  const unsigned id = strip.getCurrSegmentId();
+  if (id < MAX_NUM_SEGMENTS) particleCount[id] = numparticles;
+}
+
+uint32_t getParticleCount(const unsigned segId) {
+  if (segId >= strip.getSegmentsNum() || segId >= MAX_NUM_SEGMENTS) return 0;
+  const Segment &seg = strip.getSegment(segId);
+  if (!seg.isActive() || seg.dataSize() == 0 || !isParticleMode(seg.mode)) return 0;
+  return particleCount[segId];
+}
+
+// per frame color cache for particle rendering (see ps_colorcache.h), shared by all particle systems (segments are rendered one at a time)
+static PScolorCache *colorCache = nullptr;
+static TBlendType colorCacheBlend = LINEARBLEND;
+
+static void resetColorCache(const TBlendType blend) {
+  colorCacheBlend = blend;
+  psIdleFrames = 0;
+  if (colorCache == nullptr) {
+    colorCache = static_cast<PScolorCache *>(d_malloc(sizeof(PScolorCache)));
+    if (colorCache == nullptr) return; // no memory: colors are calculated for each particle
   }
-  return true; // particle is in bounds
+  psResetColorCache(colorCache);
+}
+
+// releases buffers shared by all particle systems once none of them was rendered for MAX_MEMIDLE frames (i.e. the last
+// particle system effect was stopped), called from strip.service() after all segments are rendered so no buffer is in use
+void servicePSmem() {
+  if (psIdleFrames > MAX_MEMIDLE) return; // already released
+  if (++psIdleFrames <= MAX_MEMIDLE) return;
+  d_free(colorCache);
+  colorCache = nullptr;
+  #ifndef WLED_DISABLE_PARTICLESYSTEM2D
+  freeSortScratch();
+  #endif
+  PSPRINTLN(F("PS shared buffers released"));
+}
+
+static uint32_t paletteColor(const uint8_t index) {
+  return ColorFromPaletteWLED(SEGPALETTE, index, 255, colorCacheBlend);
+}
+
+static uint32_t desaturateColor(uint32_t color, const uint8_t sat) {
+  CHSV32 baseHSV;
+  rgb2hsv(color, baseHSV); // convert to HSV
+  baseHSV.s = min(baseHSV.s, sat); // set the saturation but don't increase it
+  hsv2rgb(baseHSV, color); // convert back to RGB
+  return color;
+}
+
+static uint32_t cachedPaletteColor(const uint8_t index) {
+  return psCachedPaletteColor(colorCache, index, paletteColor);
+}
+
+static uint32_t cachedSaturatedColor(const uint8_t index, const uint8_t sat) {
+  return psCachedSaturatedColor(colorCache, index, sat, paletteColor, desaturateColor);
 }
 
 // this is a fast version for RGB color adding ignoring white channel (PS does not handle white) including scaling of second color
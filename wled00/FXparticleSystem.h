@@ -16,8 +16,10 @@
 
 #include <stdint.h>
 #include "wled.h"
+#include "ps_grid.h"
+#include "ps_move.h" // limitSpeed(), PS_P_MAXSPEED
+#include "ps_colorcache.h"
 
-#define PS_P_MAXSPEED 120 // maximum speed a particle can have (vx/vy is int8)
 #define MAX_MEMIDLE 10 // max idle time (in frames) before memory is deallocated (if deallocated during an effect, it will crash!)
 
 //#define WLED_DEBUG_PS // note: enabling debug uses ~3k of flash
@@ -30,10 +32,10 @@
   #define PSPRINTLN(x)
 #endif
 
-// limit speed of particles (used in 1D and 2D)
-static inline int32_t limitSpeed(const int32_t speed) {
-  return speed > PS_P_MAXSPEED ? PS_P_MAXSPEED : (speed < -PS_P_MAXSPEED ? -PS_P_MAXSPEED : speed); // note: this is slightly faster than using min/max at the cost of 50bytes of flash
-}
+// number of particles allocated by the particle system running on a segment (0 if segment does not run a particle system)
+uint32_t getParticleCount(const unsigned segId);
+// releases memory shared by all particle systems if none is running (called once per frame)
+void servicePSmem();
 #endif
 
 #ifndef WLED_DISABLE_PARTICLESYSTEM2D
@@ -60,6 +62,24 @@ static inline int32_t limitSpeed(const int32_t speed) {
 #define PS_P_MINHARDRADIUS 64 // minimum hard surface radius for collisions
 #define PS_P_MINSURFACEHARDNESS 128 // minimum hardness used in collision impulse calculation, below this hardness, particles become sticky
 
+// maximum number of collision grid cells (cells get larger on big matrices), grid memory is shared by all segments
+#ifdef ESP8266
+  #define PS_COLLISION_MAXCELLS 256
+#else
+  #define PS_COLLISION_MAXCELLS 1024
+#endif
+
+// tile binned rendering: particles are rendered tile by tile (2^PS_RENDER_TILESHIFT pixels square) to keep framebuffer writes local
+// only used on matrices with at least PS_RENDER_BINNING_MINPIXELS pixels (framebuffer does not fit the cache), 0 disables it
+#define PS_RENDER_TILESHIFT 4
+#ifndef PS_RENDER_BINNING_MINPIXELS
+  #ifdef ESP8266
+    #define PS_RENDER_BINNING_MINPIXELS 0 // no cache, framebuffer is always in DRAM
+  #else
+    #define PS_RENDER_BINNING_MINPIXELS 2048
+  #endif
+#endif
+
 // struct for PS settings (shared for 1D and 2D class)
 typedef union {
   struct{ // one byte bit field for 2D settings
@@ -163,6 +183,7 @@ public:
   void pointAttractor(const uint32_t particleindex, PSparticle &attractor, const uint8_t strength, const bool swallow);
   // set options  note: inlining the set function uses more flash so dont optimize
   void setUsedParticles(const uint8_t percentage);  // set the percentage of particles used in the system, 255=100%
+  void applyQualityLevel(); // scale used particles to the adaptive quality level (only for FX with short lived particles)
   void setCollisionHardness(const uint8_t hardness); // hardness for particle collisions (255 means full hard)
   void setWallHardness(const uint8_t hardness); // hardness for bouncing on the wall if bounceXY is set
   void setWallRoughness(const uint8_t roughness); // wall roughness randomizes wall collisions
@@ -198,6 +219,7 @@ private:
   [[gnu::hot]] void renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGBW& color, const bool wrapX, const bool wrapY);
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
+  [[gnu::hot]] void moveParticles(); // batched move of all particles using system settings (no advanced properties)
   void handleCollisions();
   [[gnu::hot]] void collideParticles(PSparticle &particle1, PSparticle &particle2, const int32_t dx, const int32_t dy, const uint32_t collDistSq);
   void fireParticleupdate();
@@ -215,7 +237,6 @@ private:
   uint32_t wallHardness;
   uint32_t wallRoughness; // randomizes wall collisions
   uint32_t particleHardRadius; // hard surface radius of a particle, used for collision detection (32bit for speed)
-  uint16_t collisionStartIdx; // particle array start index for collision detection
   uint8_t fireIntesity = 0; // fire intensity, used for fire mode (flash use optimization, better than passing an argument to render function)
   uint8_t forcecounter; // counter for globally applied forces
   uint8_t gforcecounter; // counter for global gravity
@@ -231,6 +252,7 @@ void blur2D(uint32_t *colorbuffer, const uint32_t xsize, uint32_t ysize, const u
 bool initParticleSystem2D(ParticleSystem2D *&PartSys, const uint32_t requestedsources, const uint32_t additionalbytes = 0, const bool advanced = false, const bool sizecontrol = false);
 uint32_t calculateNumberOfParticles2D(const uint32_t pixels, const bool advanced, const bool sizecontrol);
 uint32_t calculateNumberOfSources2D(const uint32_t pixels, const uint32_t requestedsources);
+uint32_t particleSystemMemory2D(const uint32_t numparticles, const uint32_t numsources, const bool advanced, const bool sizecontrol, const uint32_t additionalbytes);
 bool allocateParticleSystemMemory2D(const uint32_t numparticles, const uint32_t numsources, const bool advanced, const bool sizecontrol, const uint32_t additionalbytes);
 #endif // WLED_DISABLE_PARTICLESYSTEM2D
 
@@ -336,6 +358,7 @@ public:
   void applyFriction(const int32_t coefficient); // apply friction to all used particles
   // set options
   void setUsedParticles(const uint8_t percentage); // set the percentage of particles used in the system, 255=100%
+  void applyQualityLevel(); // scale used particles to the adaptive quality level (only for FX with short lived particles)
   void setWallHardness(const uint8_t hardness); // hardness for bouncing on the wall if bounceXY is set
   void setSize(const uint32_t x); //set particle system size (= strip length)
   void setWrap(const bool enable);
@@ -396,6 +419,7 @@ private:
 bool initParticleSystem1D(ParticleSystem1D *&PartSys, const uint32_t requestedsources, const uint8_t fractionofparticles = 255, const uint32_t additionalbytes = 0, const bool advanced = false);
 uint32_t calculateNumberOfParticles1D(const uint32_t fraction, const bool isadvanced);
 uint32_t calculateNumberOfSources1D(const uint32_t requestedsources);
+uint32_t particleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes);
 bool allocateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes);
 void blur1D(uint32_t *colorbuffer, uint32_t size, uint32_t blur, uint32_t start);
 #endif // WLED_DISABLE_PARTICLESYSTEM1D
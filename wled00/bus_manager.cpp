@@ -26,6 +26,8 @@
 #include "pin_manager.h"
 #include "bus_manager.h"
 #include "bus_wrapper.h"
+#include "dither.h"
+#include "loopback.h"
 #include <bits/unique_ptr.h>
 
 extern char cmDNS[];
@@ -102,6 +104,8 @@ extern "C" {
 
 
 static ColorOrderMap _colorOrderMap = {};
+static uint32_t _busSending = 0; // buses that were sending when last checked (see busShowFrame())
+static_assert(WLED_MAX_BUSSES <= 32, "_busSending can only track 32 buses");
 
 bool ColorOrderMap::add(uint16_t start, uint16_t len, uint8_t colorOrder) {
   if (count() >= WLED_MAX_COLOR_ORDER_MAPPINGS || len == 0 || (colorOrder & 0x0F) > COL_ORDER_MAX) return false; // upper nibble contains W swap information
@@ -141,6 +145,12 @@ void Bus::calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw) {
   cw = (w * cw) / 255;
 }
 
+#ifdef WLED_USE_16BIT_OUTPUT
+void Bus::setPixelColor64(unsigned pix, uint64_t c) {
+  setPixelColor(pix, color64to32(c)); // cheap 8 bit fallback for buses that cannot use extra depth
+}
+#endif
+
 uint32_t Bus::autoWhiteCalc(uint32_t c) const {
   unsigned aWM = _autoWhiteMode;
   if (_gAWM < AW_GLOBAL_DISABLED) aWM = _gAWM;
@@ -158,12 +168,23 @@ uint32_t Bus::autoWhiteCalc(uint32_t c) const {
 }
 
 
+// called once per frame with achieved and target FPS; dithering costs a few ns per pixel so it is suspended
+// while the strip cannot keep up with its FPS target (and for WLED_DITHER_HOLDOFF ms afterwards to avoid toggling)
+void Bus::setDitherFps(unsigned fps, unsigned targetFps) {
+  const unsigned long now = millis();
+  if (targetFps != 0 && fps + (targetFps >> 4) < targetFps) _ditherHoldoff = now; // more than ~6% behind target
+  _ditherActive = (_ditherMode != DITHER_NONE) && fps >= WLED_DITHER_MIN_FPS && (now - _ditherHoldoff >= WLED_DITHER_HOLDOFF);
+  _ditherFrame++;
+}
+
+
 BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 : Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed, (bc.refreshReq || bc.type == TYPE_TM1814))
 , _skip(bc.skipAmount) //sacrificial pixels
 , _colorOrder(bc.colorOrder)
 , _milliAmpsPerLed(bc.milliAmpsPerLed)
 , _milliAmpsMax(bc.milliAmpsMax)
+, _ditherErr(nullptr)
 {
   DEBUGBUS_PRINTLN(F("Bus: Creating digital bus."));
   if (!isDigital(bc.type) || !bc.count) { DEBUGBUS_PRINTLN(F("Not digial or empty bus!")); return; }
@@ -269,6 +290,13 @@ void BusDigital::applyBriLimit(uint8_t newBri) {
 
 void BusDigital::show() {
   if (!_valid) return;
+  // (de)allocate error buffer outside of setPixelColor() hot path; buffer is only needed for error carrying dithering
+  if (_ditherActive && _ditherMode == DITHER_ERROR) {
+    if (!_ditherErr) _ditherErr = static_cast<uint8_t*>(d_calloc(_len, 4));
+  } else if (_ditherErr) {
+    d_free(_ditherErr);
+    _ditherErr = nullptr;
+  }
   _NPBbri = (_NPBbri * _bri) / 255;      // total applied brightness for use in restoreColorLossy (see applyBriLimit())
   PolyBus::show(_busPtr, _iType, _skip); // faster if buffer consistency is not important (no skipped LEDs)
 }
@@ -291,7 +319,12 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   if (!_valid) return;
   if (hasWhite()) c = autoWhiteCalc(c);
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
-  c = color_fade(c, _bri, true); // apply brightness
+  if (_ditherActive && _bri > 0 && _bri < 255) { // brightness 0 is handled by color_fade() (always black)
+    // temporal dithering: low bits lost by brightness scaling are distributed over consecutive frames
+    if (_ditherErr && pix < _len) c = colorFadeDither(c, _bri, &_ditherErr[pix*4], nullptr);
+    else                          c = colorFadeDither(c, _bri, nullptr, &_ditherPattern[(_ditherFrame + pix) & 3]);
+  } else
+    c = color_fade(c, _bri, true); // apply brightness
 
   if (BusManager::_useABL) {
     // if using ABL, sum all color channels to estimate current and limit brightness in show()
@@ -326,6 +359,60 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   PolyBus::setPixelColor(_busPtr, _iType, pix, c, co, wwcw);
 }
 
+#ifdef WLED_USE_16BIT_OUTPUT
+// same as setPixelColor() but keeps 16 bits per channel when applying auto white, white balance and brightness
+// note: ABL (applyBriLimit()) repaints using 8 bit getPixelColor()/setPixelColor() and will lose extra depth
+void IRAM_ATTR BusDigital::setPixelColor64(unsigned pix, uint64_t c) {
+  if (!_valid) return;
+  if (!is16bit()) { setPixelColor(pix, color64to32(c)); return; } // 8 bit bus
+  uint32_t r = R16(c), g = G16(c), b = B16(c), w = W16(c);
+  if (hasWhite()) {
+    unsigned aWM = _autoWhiteMode;
+    if (_gAWM < AW_GLOBAL_DISABLED) aWM = _gAWM;
+    //ignore auto-white calculation if w>0 and mode DUAL (DUAL behaves as BRIGHTER if w==0)
+    if (aWM != RGBW_MODE_MANUAL_ONLY && !(w > 0 && aWM == RGBW_MODE_DUAL)) {
+      if (aWM == RGBW_MODE_MAX) w = r > g ? (r > b ? r : b) : (g > b ? g : b); // brightest RGB channel
+      else {
+        w = r < g ? (r < b ? r : b) : (g < b ? g : b);
+        if (aWM == RGBW_MODE_AUTO_ACCURATE) { r -= w; g -= w; b -= w; } //subtract w in ACCURATE mode
+      }
+    }
+  }
+  if (Bus::_cct >= 1900) { //color correction from CCT
+    uint32_t corr = colorBalanceFromKelvin(Bus::_cct, 0x00FFFFFF); // correction factors for each channel
+    r = (r * R(corr)) / 255;
+    g = (g * G(corr)) / 255;
+    b = (b * B(corr)) / 255;
+  }
+  if (_bri == 0) r = g = b = w = 0; // off (scaling by _bri+1 would leave up to 255 per channel)
+  else if (_bri < 255) { // apply brightness (no truncation of low values unlike 8 bit)
+    unsigned scale = _bri + 1;
+    r = (r * scale) >> 8; g = (g * scale) >> 8; b = (b * scale) >> 8; w = (w * scale) >> 8;
+  }
+
+  if (BusManager::_useABL) {
+    // if using ABL, sum all color channels to estimate current and limit brightness in show()
+    if (_milliAmpsPerLed < 255) { // normal ABL
+      _colorSum += (r >> 8) + (g >> 8) + (b >> 8) + (w >> 8);
+    } else { // wacky WS2815 power model, ignore white channel, use max of RGB (issue #549)
+      _colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b)) >> 8;
+    }
+  }
+
+  if (_reversed) pix = _len - pix -1;
+  pix += _skip;
+  const uint8_t co = _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder);
+  uint16_t ww = 0, cw = 0;
+  if (hasCCT()) {
+    uint8_t cctWW = 0, cctCW = 0;
+    Bus::calculateCCT(RGBW32(r>>8, g>>8, b>>8, 255), cctWW, cctCW); // get WW/CW ratio at full white
+    ww = (w * cctWW) / 255;
+    cw = (w * cctCW) / 255;
+  }
+  PolyBus::setPixelColor64(_busPtr, _iType, pix, RGBW64(r, g, b, w), co, ww, cw);
+}
+#endif
+
 // returns lossly restored color from bus
 uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
@@ -357,7 +444,7 @@ size_t BusDigital::getPins(uint8_t* pinArray) const {
 }
 
 size_t BusDigital::getBusSize() const {
-  return sizeof(BusDigital) + (isOk() ? PolyBus::getDataSize(_busPtr, _iType) : 0); // does not include common I2S DMA buffer
+  return sizeof(BusDigital) + (isOk() ? PolyBus::getDataSize(_busPtr, _iType) + (_ditherErr ? _len * 4 : 0) : 0); // does not include common I2S DMA buffer
 }
 
 void BusDigital::setColorOrder(uint8_t colorOrder) {
@@ -400,6 +487,8 @@ void BusDigital::begin() {
 void BusDigital::cleanup() {
   DEBUGBUS_PRINTLN(F("Digital Cleanup."));
   PolyBus::cleanup(_busPtr, _iType);
+  d_free(_ditherErr);
+  _ditherErr = nullptr;
   _iType = I_NONE;
   _valid = false;
   _busPtr = nullptr;
@@ -789,6 +878,81 @@ void BusNetwork::cleanup() {
 
 // ***************************************************************************
 
+BusLoopback::BusLoopback(const BusConfig &bc)
+: Bus(bc.type, bc.start, bc.autoWhite, bc.count)
+, _emulatedType(bc.pins[0])
+, _maxFrames(bc.pins[1] < 255 ? bc.pins[1] : 0) // 255 = unset pin field
+, _wireTime(0)
+, _txStart(0)
+, _frameCount(0)
+{
+  _hasRgb = hasRGB(bc.type);
+  _hasWhite = hasWhite(bc.type);
+  _hasCCT = false;
+  _channels = _hasWhite + 3;
+  // only single wire digital types are emulated
+  if (isDigital(_emulatedType) && !is2Pin(_emulatedType)) {
+    _wireTime = loopbackWireTime(_len, getNumberOfChannels(_emulatedType), is16bit(_emulatedType), _emulatedType == TYPE_WS2811_400KHZ);
+  } else _emulatedType = 0;
+  _data = (uint8_t*)d_calloc(_len * (_maxFrames + 1), _channels);
+  _valid = (_data != nullptr);
+  DEBUGBUS_PRINTF_P(PSTR("%successfully inited loopback strip with type %u (emulated type %u, %uus, %u frames)\n"), _valid?"S":"Uns", bc.type, _emulatedType, _wireTime, _maxFrames);
+}
+
+void BusLoopback::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_valid || pix >= _len) return;
+  if (_hasWhite) c = autoWhiteCalc(c);
+  if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
+  unsigned offset = pix * _channels;
+  _data[offset]   = R(c);
+  _data[offset+1] = G(c);
+  _data[offset+2] = B(c);
+  if (_hasWhite) _data[offset+3] = W(c);
+}
+
+uint32_t BusLoopback::getPixelColor(unsigned pix) const {
+  if (!_valid || pix >= _len) return 0;
+  unsigned offset = pix * _channels;
+  return RGBW32(_data[offset], _data[offset+1], _data[offset+2], (hasWhite() ? _data[offset+3] : 0));
+}
+
+void BusLoopback::show() {
+  if (!_valid || !canShow()) return;
+  _txStart = micros();
+  loopbackCapture(_data, _len * _channels, _maxFrames, _frameCount, _bri); // capture into ring buffer with brightness applied
+  _frameCount++;
+}
+
+const uint8_t *BusLoopback::getFrame(unsigned n) const {
+  if (!_valid) return nullptr;
+  return loopbackFrame(_data, _len * _channels, _maxFrames, _frameCount, n);
+}
+
+size_t BusLoopback::getPins(uint8_t* pinArray) const {
+  if (pinArray) {
+    pinArray[0] = _emulatedType;
+    pinArray[1] = _maxFrames;
+  }
+  return 2;
+}
+
+std::vector<LEDType> BusLoopback::getLEDTypes() {
+  return {
+    {TYPE_LOOPBACK_RGB,  "LL", PSTR("Loopback RGB (test)")},  // _pin[0] emulated LED type, _pin[1] number of captured frames
+    {TYPE_LOOPBACK_RGBW, "LL", PSTR("Loopback RGBW (test)")},
+  };
+}
+
+void BusLoopback::cleanup() {
+  DEBUGBUS_PRINTLN(F("Loopback Cleanup."));
+  d_free(_data);
+  _data = nullptr;
+  _type = I_NONE;
+  _valid = false;
+}
+
+// ***************************************************************************
+
 #ifdef WLED_ENABLE_HUB75MATRIX
 #warning "HUB75 driver enabled (experimental)"
 #ifdef ESP8266
@@ -1123,7 +1287,9 @@ size_t BusHub75Matrix::getPins(uint8_t* pinArray) const {
 
 //utility to get the approx. memory usage of a given BusConfig
 size_t BusConfig::memUsage(unsigned nr) const {
-  if (Bus::isVirtual(type)) {
+  if (Bus::isLoopback(type)) {
+    return sizeof(BusLoopback) + (count * Bus::getNumberOfChannels(type) * ((pins[1] < 255 ? pins[1] : 0) + 1));
+  } else if (Bus::isVirtual(type)) {
     return sizeof(BusNetwork) + (count * Bus::getNumberOfChannels(type));
   } else if (Bus::isDigital(type)) {
     // if any of digital buses uses I2S, there is additional common I2S DMA buffer not accounted for here
@@ -1150,12 +1316,7 @@ size_t BusManager::memUsage() {
     if (bus->isDigital() && !bus->is2Pin()) {
       digitalCount++;
       if ((PolyBus::isParallelI2S1Output() && digitalCount <= 8) || (!PolyBus::isParallelI2S1Output() && digitalCount == 1)) {
-        #ifdef NPB_CONF_4STEP_CADENCE
-        constexpr unsigned stepFactor = 4; // 4 step cadence (4 bits per pixel bit)
-        #else
-        constexpr unsigned stepFactor = 3; // 3 step cadence (3 bits per pixel bit)
-        #endif
-        unsigned i2sCommonSize = stepFactor * bus->getLength() * bus->getNumberOfChannels() * (bus->is16bit()+1);
+        unsigned i2sCommonSize = i2sMemUsage(bus->getLength() + bus->skippedLeds(), bus->getNumberOfChannels(), bus->is16bit()); // NeoPixelBus also allocates skipped LEDs
         if (i2sCommonSize > maxI2S) maxI2S = i2sCommonSize;
       }
     }
@@ -1175,7 +1336,9 @@ int BusManager::add(const BusConfig &bc) {
     if (bus->is2Pin()) twoPin++;
   }
   if (digital > WLED_MAX_DIGITAL_CHANNELS || analog > WLED_MAX_ANALOG_CHANNELS) return -1;
-  if (Bus::isVirtual(bc.type)) {
+  if (Bus::isLoopback(bc.type)) {
+    busses.push_back(make_unique<BusLoopback>(bc));
+  } else if (Bus::isVirtual(bc.type)) {
     busses.push_back(make_unique<BusNetwork>(bc));
 #ifdef WLED_ENABLE_HUB75MATRIX
   } else if (Bus::isHub75(bc.type)) {
@@ -1211,6 +1374,7 @@ String BusManager::getLEDTypesJSONString() {
   json += LEDTypesToJson(BusOnOff::getLEDTypes());
   json += LEDTypesToJson(BusPwm::getLEDTypes());
   json += LEDTypesToJson(BusNetwork::getLEDTypes());
+  json += LEDTypesToJson(BusLoopback::getLEDTypes());
   //json += LEDTypesToJson(BusVirtual::getLEDTypes());
   #ifdef WLED_ENABLE_HUB75MATRIX
   json += LEDTypesToJson(BusHub75Matrix::getLEDTypes());
@@ -1235,6 +1399,7 @@ void BusManager::removeAll() {
   //prevents crashes due to deleting busses while in use.
   while (!canAllShow()) yield();
   busses.clear();
+  _busSending = 0;
   PolyBus::setParallelI2S1Output(false);
 }
 
@@ -1320,13 +1485,50 @@ void BusManager::off() {
   _gMilliAmpsUsed = 0; // reset, assume no LED idle current if relay is off
 }
 
+// NeoPixelBus keeps an editing and a sending buffer for RMT/I2S/DMA methods and its Show() spins until the
+// previous transfer finished. Instead of waiting we leave the frame in the editing (back) buffer and send it
+// from service() once the bus is idle, so encoding frame N+1 overlaps with transmission of frame N.
 void BusManager::show() {
   applyABL(); // apply brightness limit, updates _gMilliAmpsUsed
-  for (auto &bus : busses) {
-    bus->show();
+  unsigned nr = 0;
+  for (auto &bus : busses) busShowFrame(*bus, nr++, _busSending, [](uint8_t e, uint8_t n) { traceEvent(e, n); });
+}
+
+void BusManager::service() {
+  unsigned nr = 0;
+  for (auto &bus : busses) busServiceFrame(*bus, nr++, _busSending, [](uint8_t e, uint8_t n) { traceEvent(e, n); });
+  #ifdef WLED_DEBUG_BUS
+  static unsigned long lastPrint = 0;
+  if (millis() - lastPrint > 10000) {
+    lastPrint = millis();
+    printTrace();
   }
+  #endif
+}
+
+#ifdef WLED_DEBUG_BUS
+#define BUS_TRACE_SIZE 32
+static struct { uint32_t us; uint8_t event; uint8_t bus; } _trace[BUS_TRACE_SIZE];
+static unsigned _traceIdx = 0;
+
+void BusManager::traceEvent(uint8_t event, uint8_t busNr) {
+  _trace[_traceIdx] = {(uint32_t)micros(), event, busNr};
+  _traceIdx = (_traceIdx + 1) % BUS_TRACE_SIZE;
 }
 
+// prints last BUS_TRACE_SIZE events (oldest first) with time relative to the first one
+void BusManager::printTrace() {
+  static const char *names[] = {"encode start", "encode end", "tx start", "tx defer", "tx done"};
+  const uint32_t t0 = _trace[_traceIdx].us;
+  DEBUGBUS_PRINTLN(F("Bus: timeline"));
+  for (unsigned i = 0; i < BUS_TRACE_SIZE; i++) {
+    const auto &e = _trace[(_traceIdx + i) % BUS_TRACE_SIZE];
+    if (e.us == 0) continue; // not recorded yet
+    DEBUGBUS_PRINTF_P(PSTR("%8u us %-12s bus %d\n"), (unsigned)(e.us - t0), names[e.event % 5], e.bus == 255 ? -1 : (int)e.bus);
+  }
+}
+#endif
+
 void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
   for (auto &bus : busses) {
     if (!bus->containsPixel(pix)) continue;
@@ -1334,6 +1536,15 @@ void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
   }
 }
 
+#ifdef WLED_USE_16BIT_OUTPUT
+void IRAM_ATTR BusManager::setPixelColor64(unsigned pix, uint64_t c) {
+  for (auto &bus : busses) {
+    if (!bus->containsPixel(pix)) continue;
+    bus->setPixelColor64(pix - bus->getStart(), c);
+  }
+}
+#endif
+
 void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
   if (cct > 255) cct = 255;
   if (cct >= 0) {
@@ -1444,6 +1655,10 @@ bool PolyBus::_useParallelI2S = false;
 int16_t Bus::_cct = -1;
 uint8_t Bus::_cctBlend = 0; // 0 - 127
 uint8_t Bus::_gAWM = 255;
+uint8_t Bus::_ditherMode = DITHER_NONE;
+bool    Bus::_ditherActive = false;
+uint8_t Bus::_ditherFrame = 0;
+unsigned long Bus::_ditherHoldoff = 0;
 
 uint16_t BusDigital::_milliAmpsTotal = 0;
 
@@ -15,6 +15,7 @@
 
 #include "const.h"
 #include "pin_manager.h"
+#include "bus_show.h"
 #include <vector>
 #include <memory>
 
@@ -118,6 +119,7 @@ class Bus {
     , _reversed(reversed)
     , _valid(false)
     , _needsRefresh(refresh)
+    , _showPending(false)
     {
       _autoWhiteMode = Bus::hasWhite(type) ? aw : RGBW_MODE_MANUAL_ONLY;
     };
@@ -129,6 +131,9 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c)    = 0;
+#ifdef WLED_USE_16BIT_OUTPUT
+    virtual void     setPixelColor64(unsigned pix, uint64_t c);  // 16 bit per channel, falls back to 8 bit setPixelColor()
+#endif
     virtual void     setBrightness(uint8_t b)                   { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
@@ -164,9 +169,11 @@ class Bus {
     inline  bool     isReversed() const                         { return _reversed; }
     inline  bool     isOffRefreshRequired() const               { return _needsRefresh; }
     inline  bool     containsPixel(uint16_t pix) const          { return pix >= _start && pix < _start + _len; }
+    inline  bool     isShowPending() const                      { return _showPending; }
+    inline  void     setShowPending(bool p)                     { _showPending = p; }
 
     static inline std::vector<LEDType> getLEDTypes()            { return {{TYPE_NONE, "", PSTR("None")}}; } // not used. just for reference for derived classes
-    static constexpr size_t   getNumberOfPins(uint8_t type)     { return isVirtual(type) ? 4 : isPWM(type) ? numPWMPins(type) : isHub75(type) ? 3 : is2Pin(type) + 1; } // credit @PaoloTK
+    static constexpr size_t   getNumberOfPins(uint8_t type)     { return isVirtual(type) ? 4 : isPWM(type) ? numPWMPins(type) : isHub75(type) ? 3 : isLoopback(type) ? 2 : is2Pin(type) + 1; } // credit @PaoloTK
     static constexpr size_t   getNumberOfChannels(uint8_t type) { return hasWhite(type) + 3*hasRGB(type) + hasCCT(type); }
     static constexpr bool hasRGB(uint8_t type) {
       return !((type >= TYPE_WS2812_1CH && type <= TYPE_WS2812_WWA) || type == TYPE_ANALOG_1CH || type == TYPE_ANALOG_2CH || type == TYPE_ONOFF);
@@ -176,7 +183,8 @@ class Bus {
               type == TYPE_SK6812_RGBW || type == TYPE_TM1814 || type == TYPE_UCS8904 ||
               type == TYPE_FW1906 || type == TYPE_WS2805 || type == TYPE_SM16825 ||        // digital types with white channel
               (type > TYPE_ONOFF && type <= TYPE_ANALOG_5CH && type != TYPE_ANALOG_3CH) || // analog types with white channel
-              type == TYPE_NET_DDP_RGBW || type == TYPE_NET_ARTNET_RGBW;                   // network types with white channel
+              type == TYPE_NET_DDP_RGBW || type == TYPE_NET_ARTNET_RGBW ||                 // network types with white channel
+              type == TYPE_LOOPBACK_RGBW;
     }
     static constexpr bool hasCCT(uint8_t type) {
       return  type == TYPE_WS2812_2CH_X3 || type == TYPE_WS2812_WWA ||
@@ -190,6 +198,7 @@ class Bus {
     static constexpr bool  isOnOff(uint8_t type)      { return (type == TYPE_ONOFF); }
     static constexpr bool  isPWM(uint8_t type)        { return (type >= TYPE_ANALOG_MIN && type <= TYPE_ANALOG_MAX); }
     static constexpr bool  isVirtual(uint8_t type)    { return (type >= TYPE_VIRTUAL_MIN && type <= TYPE_VIRTUAL_MAX); }
+    static constexpr bool  isLoopback(uint8_t type)   { return (type >= TYPE_LOOPBACK_MIN && type <= TYPE_LOOPBACK_MAX); }
     static constexpr bool  isHub75(uint8_t type)      { return (type >= TYPE_HUB75MATRIX_MIN && type <= TYPE_HUB75MATRIX_MAX); }
     static constexpr bool  is16bit(uint8_t type)      { return type == TYPE_UCS8903 || type == TYPE_UCS8904 || type == TYPE_SM16825; }
     static constexpr bool  mustRefresh(uint8_t type)  { return type == TYPE_TM1814; }
@@ -208,6 +217,10 @@ class Bus {
       #endif
     }
     static void calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw);
+    static inline void     setDitherMode(uint8_t m)   { _ditherMode = m <= DITHER_ORDERED ? m : DITHER_NONE; }
+    static inline uint8_t  getDitherMode()            { return _ditherMode; }
+    static inline bool     isDitherActive()           { return _ditherActive; }
+    static void            setDitherFps(unsigned fps, unsigned targetFps); // called once per frame
 
   protected:
     uint8_t  _type;
@@ -223,6 +236,7 @@ class Bus {
       bool _hasRgb;//       : 1;
       bool _hasWhite;//     : 1;
       bool _hasCCT;//       : 1;
+      bool _showPending;//  : 1; frame is encoded but previous one was still being sent (see BusManager::show())
     //} __attribute__ ((packed));
     static uint8_t _gAWM;
     // _cct has the following meanings (see calculateCCT() & BusManager::setSegmentCCT()):
@@ -235,6 +249,11 @@ class Bus {
     //   63 - semi additive/nonlinear (CCT 127 => 66% warm, 66% cold)
     //  127 - additive CCT blending (CCT 127 => 100% warm, 100% cold)
     static uint8_t _cctBlend;
+    // temporal dithering (see BusDigital::setPixelColor()), _ditherActive is updated each frame from achieved FPS
+    static uint8_t _ditherMode;
+    static bool    _ditherActive;
+    static uint8_t _ditherFrame;
+    static unsigned long _ditherHoldoff; // last time achieved FPS fell behind target
 
     uint32_t autoWhiteCalc(uint32_t c) const;
 };
@@ -249,6 +268,9 @@ class BusDigital : public Bus {
     bool canShow() const override;
     void setStatusPixel(uint32_t c) override;
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+#ifdef WLED_USE_16BIT_OUTPUT
+    [[gnu::hot]] void setPixelColor64(unsigned pix, uint64_t c) override;
+#endif
     void setColorOrder(uint8_t colorOrder) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
@@ -278,6 +300,7 @@ class BusDigital : public Bus {
     uint16_t _milliAmpsLimit;
     uint32_t _colorSum; // total color value for the bus, updated in setPixelColor(), used to estimate current
     void    *_busPtr;
+    uint8_t *_ditherErr; // per-pixel, per-channel quantization remainder carried between frames (DITHER_ERROR only)
 
     static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
 
@@ -372,6 +395,38 @@ class BusNetwork : public Bus {
     #endif
 };
 
+// bus without any output: accepts pixels at full speed, keeps last N frames in RAM and optionally
+// emulates wire time of a digital LED type (canShow() is false until the frame would have been sent)
+// used to benchmark BusManager/WS2812FX pipeline without hardware and to compare rendered frames
+class BusLoopback : public Bus {
+  public:
+    BusLoopback(const BusConfig &bc);
+    ~BusLoopback() { cleanup(); }
+
+    bool canShow() const override  { return micros() - _txStart >= _wireTime; }
+    [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
+    size_t getPins(uint8_t* pinArray = nullptr) const override;
+    size_t getBusSize() const override  { return sizeof(BusLoopback) + (isOk() ? _len * _channels * (_maxFrames + 1) : 0); }
+    void   show() override;
+    void   cleanup();
+
+    inline uint32_t getFrameCount() const { return _frameCount; } // number of frames shown since creation
+    inline uint32_t getWireTime() const   { return _wireTime; }   // emulated transmission time in us
+    const uint8_t  *getFrame(unsigned n = 0) const;               // n-th most recent captured frame (0 = last shown), nullptr if not captured
+
+    static std::vector<LEDType> getLEDTypes();
+
+  private:
+    uint8_t   _emulatedType; // LED type whose wire time is emulated (0 = none)
+    uint8_t   _maxFrames;    // number of frames kept in capture buffer
+    uint8_t   _channels;
+    uint32_t  _wireTime;
+    uint32_t  _txStart;
+    uint32_t  _frameCount;
+    uint8_t   *_data;        // current frame followed by ring buffer of captured frames
+};
+
 #ifdef WLED_ENABLE_HUB75MATRIX
 class BusHub75Matrix : public Bus {
   public:
@@ -492,6 +547,14 @@ namespace BusManager {
   }
 
   size_t          memUsage();
+  // size of I2S DMA buffer for a digital bus (shared by all I2S buses, largest bus determines the size)
+  constexpr unsigned i2sMemUsage(unsigned count, unsigned channels, bool is16bit) {
+  #ifdef NPB_CONF_4STEP_CADENCE
+    return 4 * count * channels * (is16bit+1); // 4 step cadence (4 bits per pixel bit)
+  #else
+    return 3 * count * channels * (is16bit+1); // 3 step cadence (3 bits per pixel bit)
+  #endif
+  }
   inline uint16_t currentMilliamps()            { return _gMilliAmpsUsed + MA_FOR_ESP; }
   //inline uint16_t ablMilliampsMax()             { unsigned sum = 0; for (auto &bus : busses) sum += bus->getMaxCurrent(); return sum; }
   inline uint16_t ablMilliampsMax()             { return _gMilliAmpsMax; }  // used for compatibility reasons (and enabling virtual global ABL)
@@ -510,9 +573,21 @@ namespace BusManager {
   void off();
 
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+#ifdef WLED_USE_16BIT_OUTPUT
+  [[gnu::hot]] void     setPixelColor64(unsigned pix, uint64_t c);
+  inline bool           has16bitBus() { for (const auto &bus : busses) if (bus->is16bit()) return true; return false; }
+#endif
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
-  void        show();
+  void        show();       // does not block: buses still sending the previous frame are flushed in service()
+  void        service();    // sends deferred frames and detects finished transfers, call once per loop()
   bool        canAllShow();
+  inline bool isShowPending()            { for (const auto &bus : busses) if (bus->isShowPending()) return true; return false; }
+  #ifdef WLED_DEBUG_BUS
+  void        traceEvent(uint8_t event, uint8_t busNr = 255);
+  void        printTrace();
+  #else
+  inline void traceEvent(uint8_t event, uint8_t busNr = 255) {}
+  #endif
   inline void setStatusPixel(uint32_t c) { for (auto &bus : busses) bus->setStatusPixel(c);}
   inline void setBrightness(uint8_t b)   { for (auto &bus : busses) bus->setBrightness(b); }
   // for setSegmentCCT(), cct can only be in [-1,255] range; allowWBCorrection will convert it to K
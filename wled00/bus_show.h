@@ -0,0 +1,49 @@
+#pragma once
+#ifndef WLED_BUS_SHOW_H
+#define WLED_BUS_SHOW_H
+/*
+ * Non-blocking frame hand-off used by BusManager::show() and BusManager::service()
+ * kept free of Arduino dependencies so it can be verified on the host with a fake bus (tools/bus_show_test.cpp)
+ * B needs canShow(), show(), isShowPending() and setShowPending(bool); T is called as trace(event, busNr)
+ */
+#include <stdint.h>
+
+// timeline trace of frame encoding and transmission (WLED_DEBUG_BUS only), see BusManager::traceEvent()
+#define BUS_TRACE_ENCODE_START 0 // WS2812FX::show() starts painting buses
+#define BUS_TRACE_ENCODE_END   1 // all pixels painted
+#define BUS_TRACE_TX_START     2 // bus started sending a frame
+#define BUS_TRACE_TX_DEFER     3 // bus was still sending previous frame, new frame is kept in back buffer
+#define BUS_TRACE_TX_DONE      4 // bus finished sending (detected in BusManager::service())
+
+// a new frame was painted: send it if the bus is idle, otherwise keep it in the back buffer until service() finds the bus idle
+// sending is a bit mask of buses that are (or were when last checked) transmitting
+template<class B, class T>
+static inline void busShowFrame(B &bus, unsigned nr, uint32_t &sending, T trace) {
+  if (bus.canShow()) {
+    trace(BUS_TRACE_TX_START, nr);
+    bus.show();
+    bus.setShowPending(false);
+    sending |= (1UL << nr);
+  } else {
+    trace(BUS_TRACE_TX_DEFER, nr);
+    bus.setShowPending(true); // newer frame supersedes any frame still pending
+  }
+}
+
+// polled from loop(): there is no transmission complete callback, a bus is done once canShow() returns true
+template<class B, class T>
+static inline void busServiceFrame(B &bus, unsigned nr, uint32_t &sending, T trace) {
+  const bool idle = bus.canShow();
+  if (idle && (sending & (1UL << nr))) {
+    trace(BUS_TRACE_TX_DONE, nr);
+    sending &= ~(1UL << nr);
+  }
+  if (idle && bus.isShowPending()) {
+    trace(BUS_TRACE_TX_START, nr);
+    bus.show();
+    bus.setShowPending(false);
+    sending |= (1UL << nr);
+  }
+}
+
+#endif
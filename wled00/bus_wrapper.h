@@ -904,6 +904,66 @@ class PolyBus {
     }
   }
 
+#ifdef WLED_USE_16BIT_OUTPUT
+  // 16 bit per channel variant of setPixelColor() for UCS8903, UCS8904 & SM16825, other types use 8 bit fallback
+  [[gnu::hot]] static void setPixelColor64(void* busPtr, uint8_t busType, uint16_t pix, uint64_t c, uint8_t co, uint16_t ww = 0, uint16_t cw = 0) {
+    uint16_t r = R16(c);
+    uint16_t g = G16(c);
+    uint16_t b = B16(c);
+    uint16_t w = W16(c);
+    const uint16_t wwcw = ((cw >> 8) << 8) | (ww >> 8); // for 8 bit fallback (before swapping)
+    Rgbw64Color col;
+
+    // reorder channels to selected order
+    switch (co & 0x0F) {
+      default: col.G = g; col.R = r; col.B = b; break; //0 = GRB, default
+      case  1: col.G = r; col.R = g; col.B = b; break; //1 = RGB, common for WS2811
+      case  2: col.G = b; col.R = r; col.B = g; break; //2 = BRG
+      case  3: col.G = r; col.R = b; col.B = g; break; //3 = RBG
+      case  4: col.G = b; col.R = g; col.B = r; break; //4 = BGR
+      case  5: col.G = g; col.R = b; col.B = r; break; //5 = GBR
+    }
+    // upper nibble contains W swap information
+    switch (co >> 4) {
+      default: col.W = w;                break; // no swapping
+      case  1: col.W = col.B; col.B = w; break; // swap W & B
+      case  2: col.W = col.G; col.G = w; break; // swap W & G
+      case  3: col.W = col.R; col.R = w; break; // swap W & R
+      case  4: std::swap(ww, cw);        break; // swap WW & CW
+    }
+
+    switch (busType) {
+    #ifdef ESP8266
+      case I_8266_U0_UCS_3: (static_cast<B_8266_U0_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_U1_UCS_3: (static_cast<B_8266_U1_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_DM_UCS_3: (static_cast<B_8266_DM_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_BB_UCS_3: (static_cast<B_8266_BB_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_U0_UCS_4: (static_cast<B_8266_U0_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_U1_UCS_4: (static_cast<B_8266_U1_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_DM_UCS_4: (static_cast<B_8266_DM_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_BB_UCS_4: (static_cast<B_8266_BB_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_U0_SM16825_5: (static_cast<B_8266_U0_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, ww, cw)); break;
+      case I_8266_U1_SM16825_5: (static_cast<B_8266_U1_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, ww, cw)); break;
+      case I_8266_DM_SM16825_5: (static_cast<B_8266_DM_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, ww, cw)); break;
+      case I_8266_BB_SM16825_5: (static_cast<B_8266_BB_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, ww, cw)); break;
+    #endif
+    #ifdef ARDUINO_ARCH_ESP32
+      // RMT buses
+      case I_32_RN_UCS_3: (static_cast<B_32_RN_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_32_RN_UCS_4: (static_cast<B_32_RN_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_32_RN_SM16825_5: (static_cast<B_32_RN_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, ww, cw)); break;
+      // I2S1 bus or paralell buses
+      #ifndef CONFIG_IDF_TARGET_ESP32C3
+      case I_32_I2_UCS_3: if (_useParallelI2S) (static_cast<B_32_IP_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); else (static_cast<B_32_I2_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_32_I2_UCS_4: if (_useParallelI2S) (static_cast<B_32_IP_UCS_4*>(busPtr))->SetPixelColor(pix, col); else (static_cast<B_32_I2_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_32_I2_SM16825_5: if (_useParallelI2S) (static_cast<B_32_IP_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, ww, cw)); else (static_cast<B_32_I2_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, ww, cw)); break;
+      #endif
+    #endif
+      default: setPixelColor(busPtr, busType, pix, color64to32(c), co, wwcw); break; // not a 16 bit bus
+    }
+  }
+#endif
+
   [[gnu::hot]] static uint32_t getPixelColor(void* busPtr, uint8_t busType, uint16_t pix, uint8_t co) {
     RgbwColor col(0,0,0,0);
     switch (busType) {
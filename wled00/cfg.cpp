@@ -165,6 +165,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   uint8_t cctBlending = hw_led[F("cb")] | Bus::getCCTBlend();
   Bus::setCCTBlend(cctBlending);
   strip.setTargetFps(hw_led["fps"]); //NOP if 0, default 42 FPS
+  CJSON(strip.adaptiveQuality, hw_led[F("aq")]);
+  Bus::setDitherMode(hw_led[F("dith")] | Bus::getDitherMode());
   #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
   CJSON(useParallelI2S, hw_led[F("prl")]);
   #endif
@@ -229,7 +231,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       uint8_t maPerLed = elm[F("ledma")] | LED_MILLIAMPS_DEFAULT;
       uint16_t maMax = elm[F("maxpwr")] | (ablMilliampsMax * length) / total; // rough (incorrect?) per strip ABL calculation when no config exists
       // To disable brightness limiter we either set output max current to 0 or single LED current to 0 (we choose output max current)
-      if (Bus::isPWM(ledType) || Bus::isOnOff(ledType) || Bus::isVirtual(ledType)) { // analog and virtual
+      if (Bus::isPWM(ledType) || Bus::isOnOff(ledType) || Bus::isVirtual(ledType) || Bus::isLoopback(ledType)) { // analog, virtual and loopback
         maPerLed = 0;
         maMax = 0;
       }
@@ -238,7 +240,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       String host = elm[F("text")] | String();
       busConfigs.emplace_back(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, maPerLed, maMax, host);
       doInitBusses = true;  // finalization done in beginStrip()
-      if (!Bus::isVirtual(ledType)) s++; // have as many virtual buses as you want
+      if (!Bus::isVirtual(ledType) && !Bus::isLoopback(ledType)) s++; // have as many virtual buses as you want
     }
   } else if (fromFS) {
     //if busses failed to load, add default (fresh install, FS issue, ...)
@@ -938,6 +940,8 @@ void serializeConfig(JsonObject root) {
   hw_led[F("ic")] = cctICused;
   hw_led[F("cb")] = Bus::getCCTBlend();
   hw_led["fps"] = strip.getTargetFps();
+  hw_led[F("aq")] = strip.adaptiveQuality;
+  hw_led[F("dith")] = Bus::getDitherMode();
   hw_led[F("rgbwm")] = Bus::getGlobalAWMode(); // global auto white mode override
   #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
   hw_led[F("prl")] = BusManager::hasParallelOutput();
@@ -291,6 +291,7 @@ void loadCustomPalettes() {
       break;
     }
   }
+  invalidateStaticJson(); // palette list served by /json/palx has changed
 }
 
 void hsv2rgb(const CHSV32& hsv, uint32_t& rgb) // convert HSV (16bit hue) to RGB (32bit with white = 0)
@@ -580,6 +581,9 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb) {
 // gamma lookup tables used for color correction (filled on 1st use (cfg.cpp & set.cpp))
 uint8_t NeoGammaWLEDMethod::gammaT[256];
 uint8_t NeoGammaWLEDMethod::gammaT_inv[256];
+#ifdef WLED_USE_16BIT_OUTPUT
+uint16_t NeoGammaWLEDMethod::gammaT16[256];
+#endif
 
 // re-calculates & fills gamma tables
 void NeoGammaWLEDMethod::calcGammaTable(float gamma)
@@ -588,10 +592,16 @@ void NeoGammaWLEDMethod::calcGammaTable(float gamma)
   for (size_t i = 1; i < 256; i++) {
     gammaT[i] = (int)(powf((float)i / 255.0f, gamma) * 255.0f + 0.5f);
     gammaT_inv[i] = (int)(powf(((float)i - 0.5f) / 255.0f, gamma_inv) * 255.0f + 0.5f);
+    #ifdef WLED_USE_16BIT_OUTPUT
+    gammaT16[i] = (int)(powf((float)i / 255.0f, gamma) * 65535.0f + 0.5f); // keeps low values that 8 bit table truncates to 0
+    #endif
     //DEBUG_PRINTF_P(PSTR("gammaT[%d] = %d gammaT_inv[%d] = %d\n"), i, gammaT[i], i, gammaT_inv[i]);
   }
   gammaT[0] = 0;
   gammaT_inv[0] = 0;
+  #ifdef WLED_USE_16BIT_OUTPUT
+  gammaT16[0] = 0;
+  #endif
 }
 
 uint8_t NeoGammaWLEDMethod::Correct(uint8_t value)
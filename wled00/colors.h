@@ -91,6 +91,20 @@ struct CHSV32 { // 32bit HSV color with 16bit hue for more accurate conversions
     : h((uint16_t)chsv.h << 8), s(chsv.s), v(chsv.v) {}
   inline operator CHSV() const { return CHSV((uint8_t)(h >> 8), s, v); } // typecast to CHSV
 };
+#ifdef WLED_USE_16BIT_OUTPUT
+// 16 bit per channel color (0xWWWWRRRRGGGGBBBB), only used on the output path to 16 bit buses (UCS8903, UCS8904, SM16825)
+// effects, segment and frame buffers remain 8 bit per channel (RGBW32), conversion happens when gamma is applied
+#define RGBW64(r,g,b,w) ((uint64_t(uint16_t(w)) << 48) | (uint64_t(uint16_t(r)) << 32) | (uint64_t(uint16_t(g)) << 16) | uint64_t(uint16_t(b)))
+#define R16(c) (uint16_t((c) >> 32))
+#define G16(c) (uint16_t((c) >> 16))
+#define B16(c) (uint16_t(c))
+#define W16(c) (uint16_t((c) >> 48))
+// 8 bit fallback with rounding (exact for values expanded by 257)
+inline uint32_t color64to32(uint64_t c) {
+  const auto to8 = [](unsigned v) { return (v - (v >> 8) + 128) >> 8; };
+  return (to8(W16(c)) << 24) | (to8(R16(c)) << 16) | (to8(G16(c)) << 8) | to8(B16(c));
+}
+#endif
 extern bool gammaCorrectCol;
 // similar to NeoPixelBus NeoGammaTableMethod but allows dynamic changes (superseded by NPB::NeoGammaDynamicTableMethod)
 class NeoGammaWLEDMethod {
@@ -106,11 +120,24 @@ class NeoGammaWLEDMethod {
       w = gammaT[w]; r = gammaT[r]; g = gammaT[g]; b = gammaT[b];
       return (uint32_t(w) << 24) | (uint32_t(r) << 16) | (uint32_t(g) << 8) | uint32_t(b);
     }
+#ifdef WLED_USE_16BIT_OUTPUT
+    static inline uint64_t Correct64(uint32_t color) { // apply Gamma to RGBW32 color returning 16 bit per channel (WLED specific, 16 bit buses only)
+      uint8_t  w = byte(color>>24), r = byte(color>>16), g = byte(color>>8), b = byte(color); // extract r, g, b, w channels
+      if (!gammaCorrectCol) return RGBW64(r*257, g*257, b*257, w*257); // no gamma correction, just expand to 16 bit
+      return RGBW64(gammaT16[r], gammaT16[g], gammaT16[b], gammaT16[w]);
+    }
+#endif
   private:
     static uint8_t gammaT[];
     static uint8_t gammaT_inv[];
+#ifdef WLED_USE_16BIT_OUTPUT
+    static uint16_t gammaT16[];
+#endif
 };
 #define gamma32(c) NeoGammaWLEDMethod::Correct32(c)
+#ifdef WLED_USE_16BIT_OUTPUT
+#define gamma64(c) NeoGammaWLEDMethod::Correct64(c)
+#endif
 #define gamma8(c)  NeoGammaWLEDMethod::rawGamma8(c)
 #define gamma32inv(c) NeoGammaWLEDMethod::inverseGamma32(c)
 #define gamma8inv(c)  NeoGammaWLEDMethod::rawInverseGamma8(c)
@@ -140,13 +167,7 @@ uint32_t colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb);
 uint16_t approximateKelvinFromRGB(uint32_t rgb);
 void setRandomColor(byte* rgb);
 
-// fast scaling function for colors, performs color*scale/256 for all four channels, speed over accuracy
-// note: inlining uses less code than actual function calls
-static inline uint32_t fast_color_scale(const uint32_t c, const uint8_t scale) {
-  uint32_t rb = (((c     & 0x00FF00FF) * scale) >> 8) &  0x00FF00FF;
-  uint32_t wg = (((c>>8) & 0x00FF00FF) * scale)       & ~0x00FF00FF;
-  return rb | wg;
-}
+#include "pixel_blur.h" // fast_color_scale(), fast_color_add() and the blur kernels
 
 // palettes
 extern const TProgmemRGBPalette16* const fastledPalettes[];
@@ -233,6 +233,23 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define CALL_MODE_WS_SEND       11     //special call mode, not for notifier, updates websocket only
 #define CALL_MODE_BUTTON_PRESET 12     //button/IR JSON preset/macro
 
+//binary control protocol (UDP notifier port, WebSocket binary), see handleControlPacket()
+#define CONTROL_PROTOCOL_ID     0xC5   //first byte of control message (also the WebSocket binary protocol byte)
+#define CTRL_BRI                0x01   //master brightness (1 byte)
+#define CTRL_SEG_BRI            0x02   //segment opacity, 0 turns segment off (1 byte)
+#define CTRL_SEG_ON             0x03   //segment on/off (1 byte)
+#define CTRL_SPEED              0x04   //effect speed (1 byte)
+#define CTRL_INTENSITY          0x05   //effect intensity (1 byte)
+#define CTRL_CUSTOM1            0x06   //custom1 (1 byte)
+#define CTRL_CUSTOM2            0x07   //custom2 (1 byte)
+#define CTRL_CUSTOM3            0x08   //custom3 (1 byte, 0-31)
+#define CTRL_PALETTE            0x09   //palette (1 byte)
+#define CTRL_EFFECT             0x0A   //effect (1 byte)
+#define CTRL_COL1               0x0B   //primary color (4 bytes RGBW)
+#define CTRL_COL2               0x0C   //secondary color (4 bytes RGBW)
+#define CTRL_COL3               0x0D   //tertiary color (4 bytes RGBW)
+#define CTRL_ALL_SELECTED       255    //segment id addressing all selected segments
+
 //RGB to RGBW conversion mode
 #define RGBW_MODE_MANUAL_ONLY     0    // No automatic white channel calculation. Manual white channel slider
 #define RGBW_MODE_AUTO_BRIGHTER   1    // New algorithm. Adds as much white as the darkest RGBW channel
@@ -242,6 +259,17 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 //#define RGBW_MODE_LEGACY        4    // Old floating algorithm. Too slow for realtime and palette support (unused)
 #define AW_GLOBAL_DISABLED      255    // Global auto white mode override disabled. Per-bus setting is used
 
+//temporal dithering modes for digital buses (applied when scaling colors by bus brightness)
+#define DITHER_NONE               0    // plain 8 bit brightness scaling (truncates)
+#define DITHER_ERROR              1    // carry each pixel's quantization error into the next frame (needs 4 bytes per LED)
+#define DITHER_ORDERED            2    // 4-frame ordered (Bayer) threshold pattern, phase shifted per pixel (no extra memory)
+#ifndef WLED_DITHER_MIN_FPS
+  #define WLED_DITHER_MIN_FPS    60    // dithering is only applied if achieved FPS is at least this high (avoids visible flicker)
+#endif
+#ifndef WLED_DITHER_HOLDOFF
+  #define WLED_DITHER_HOLDOFF  5000    // ms dithering stays off after achieved FPS fell behind the FPS target
+#endif
+
 //realtime modes
 #define REALTIME_MODE_INACTIVE    0
 #define REALTIME_MODE_GENERIC     1
@@ -330,6 +358,12 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define TYPE_HUB75MATRIX_QS      66
 #define TYPE_HUB75MATRIX_MAX     71
 
+//Loopback types (no output, capture frames & emulate wire time for testing) (72-79)
+#define TYPE_LOOPBACK_MIN        72
+#define TYPE_LOOPBACK_RGB        72            //loopback RGB bus
+#define TYPE_LOOPBACK_RGBW       73            //loopback RGBW bus
+#define TYPE_LOOPBACK_MAX        79
+
 //Network types (master broadcast) (80-95)
 #define TYPE_VIRTUAL_MIN         80
 #define TYPE_NET_DDP_RGB         80            //network DDP RGB bus (master broadcast bus)
@@ -497,6 +531,11 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define MAX_LEDS_PER_BUS 2048   // may not be enough for fast LEDs (i.e. APA102)
 #endif
 
+// parallel I2S (ESP32, S2, S3) is only used if no digital bus exceeds this length (NeoPixelBus 2.8.3 glitches on longer buses)
+#ifndef WLED_MAX_LEDS_PER_PARALLEL_BUS
+#define WLED_MAX_LEDS_PER_PARALLEL_BUS 600
+#endif
+
 // string temp buffer (now stored in stack locally)
 #ifdef ESP8266
 #define SETTINGS_STACK_BUF_SIZE 2560
@@ -560,6 +599,20 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
   #endif
 #endif
 
+// number of additional JSON documents leased to read-only requests (GET /json, WS state pushes) so they do not wait for the global buffer
+// documents are allocated at boot only if there is enough PSRAM/heap (see initJSONDocumentPool())
+// without PSRAM each document permanently takes JSON_BUFFER_SIZE of DRAM, so it has to be enabled explicitly (ESP32 only)
+#ifndef WLED_JSON_POOL_SIZE
+  #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
+    #define WLED_JSON_POOL_SIZE 3
+  #else
+    #define WLED_JSON_POOL_SIZE 0
+  #endif
+#endif
+#if defined(ESP8266) && WLED_JSON_POOL_SIZE > 0
+  #error WLED_JSON_POOL_SIZE is not supported on ESP8266
+#endif
+
 // minimum heap size required to process web requests: try to keep free heap above this value
 #ifdef ESP8266
   #define MIN_HEAP_SIZE (9*1024)
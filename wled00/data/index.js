@@ -26,6 +26,7 @@ var pmt = 1, pmtLS = 0, pmtLast = 0;
 var lastinfo = {};
 var isM = false, mw = 0, mh=0;
 var ws, wsRpt=0;
+var wsV = 0, wsS = null; // WS state delta subscription: acknowledged version and state it describes
 var cfg = {
 	theme:{base:"dark", bg:{url:"", rnd: false, rndGrayscale: false, rndBlur: false}, alpha:{bg:0.6,tab:0.8}, color:{bg:""}},
 	comp :{colors:{picker: true, rgb: false, quick: true, hex: false},
@@ -740,6 +741,7 @@ ${inforow("Free heap",(i.freeheap/1024).toFixed(1)," kB")}
 ${i.psram?inforow("Free PSRAM",(i.psram/1024).toFixed(1)," kB"):""}
 ${inforow("Estimated current",pwru)}
 ${inforow("Average FPS",i.leds.fps)}
+${i.leds.q!==undefined?inforow("Effect quality",Math.round(i.leds.q*100/255),"%"):""}
 ${inforow("MAC address",i.mac)}
 ${inforow("CPU clock",i.clock," MHz")}
 ${inforow("Flash size",i.flash," MB")}
@@ -1419,6 +1421,17 @@ function makeWS() {
 		if (e.data instanceof ArrayBuffer) return; // liveview packet
 		var json = JSON.parse(e.data);
 		if (json.leds) return; // JSON liveview packet
+		if (json.d) { // state delta (see ws.cpp)
+			if (!wsS || json.b !== wsV) return; // not based on our version, a full update follows
+			applyDelta(json.d);
+			wsV = json.v;
+			ws.send(`{"ack":${wsV}}`);
+			json = {state: wsS};
+		} else if (json.state && json.v !== undefined) {
+			wsS = json.state;
+			wsV = json.v;
+			if (wsV) ws.send(`{"ack":${wsV}}`); // version 0: reply to this client only, next broadcast resyncs
+		}
 		clearTimeout(jsonTimeout);
 		jsonTimeout = null;
 		lastUpdate = new Date();
@@ -1439,14 +1452,32 @@ function makeWS() {
 		gId('connind').style.backgroundColor = "var(--c-r)";
 		if (wsRpt++ < 5) setTimeout(makeWS,1500); // retry WS connection
 		ws = null;
+		wsS = null;
 	}
 	ws.onopen = (e)=>{
 		//ws.send("{'v':true}"); // unnecessary (https://github.com/wled/WLED/blob/master/wled00/ws.cpp#L18)
+		ws.send('{"diff":true}'); // subscribe to state deltas
 		wsRpt = 0;
 		reqsLegal = true;
 	}
 }
 
+// merges a WS state delta into the last received state
+function applyDelta(d)
+{
+	for (const [k,v] of Object.entries(d)) if (k !== "seg") wsS[k] = v;
+	if (!d.seg) return;
+	if (!wsS.seg) wsS.seg = [];
+	for (const sd of d.seg) {
+		let i = wsS.seg.findIndex((s)=>s.id === sd.id);
+		if (sd.stop === 0) { if (i >= 0) wsS.seg.splice(i,1); continue; } // removed segment
+		if (i < 0) {
+			wsS.seg.push(sd);
+			wsS.seg.sort((a,b)=>a.id-b.id);
+		} else Object.assign(wsS.seg[i], sd);
+	}
+}
+
 function readState(s,command=false)
 {
 	if (!s) return false;
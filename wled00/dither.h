@@ -0,0 +1,45 @@
+#pragma once
+#ifndef WLED_DITHER_H
+#define WLED_DITHER_H
+/*
+ * Temporal dithering of brightness scaling for digital buses (see BusDigital::setPixelColor())
+ * kept free of Arduino dependencies so it can be verified on the host (tools/dither_test.cpp)
+ */
+#include <stdint.h>
+
+// ordered dithering thresholds for 4 consecutive frames (flattened 2x2 Bayer matrix, 8 bit fraction)
+static const uint8_t _ditherPattern[4] = { 0, 128, 192, 64 };
+
+// scales color by brightness like color_fade(c, bri, true) but adds a sub-LSB threshold before truncating so that
+// over several frames the average output matches the exact 16 bit product (temporal dithering)
+// err holds the per-channel remainders (B,G,R,W order of color bytes) and is updated if threshold is nullptr
+// like "video" scaling a channel that is on never drops to 0 unless it is negligible compared to the dominant channel
+// two channels are scaled per multiplication (16 bit lanes): bri < 255 so product plus threshold never exceeds a lane
+static inline __attribute__((always_inline)) uint32_t colorFadeDither(uint32_t c, uint8_t bri, uint8_t *err, const uint8_t *threshold) {
+  if (c == 0 || bri == 0) return 0;
+  const uint32_t scale = bri + 1;
+  uint32_t add;
+  if (threshold) add = *threshold * 0x01010101U;
+  else           add = err[0] | (err[1] << 8) | (err[2] << 16) | ((uint32_t)err[3] << 24);
+  const uint32_t rb = (c & 0x00FF00FF) * scale + (add & 0x00FF00FF);        // blue and red lanes
+  const uint32_t gw = ((c >> 8) & 0x00FF00FF) * scale + ((add >> 8) & 0x00FF00FF); // green and white lanes
+  uint32_t out = ((rb >> 8) & 0x00FF00FF) | (gw & 0xFF00FF00);
+  if (!threshold) { // carry remainders into next frame
+    err[0] = rb; err[1] = gw; err[2] = rb >> 16; err[3] = gw >> 16;
+  }
+  // channels that were on but truncated to 0 (rare unless brightness is very low): byte wise "is non zero" masks
+  const uint32_t onIn  = (((c   & 0x7F7F7F7FU) + 0x7F7F7F7FU) | c)   & 0x80808080U;
+  const uint32_t onOut = (((out & 0x7F7F7F7FU) + 0x7F7F7F7FU) | out) & 0x80808080U;
+  uint32_t lost = onIn & ~onOut;
+  if (lost) {
+    const uint8_t r = c >> 16, g = c >> 8, b = c;
+    const uint8_t maxc = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b); // dominant channel for hue preservation (same rule as color_fade())
+    if ((b<<5) <= maxc) lost &= ~0x00000080U; // negligible channels may go dark
+    if ((g<<5) <= maxc) lost &= ~0x00008000U;
+    if ((r<<5) <= maxc) lost &= ~0x00800000U;
+    out |= lost >> 7; // channel that is on stays at minimum value (white always does)
+  }
+  return out;
+}
+
+#endif
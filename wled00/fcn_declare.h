@@ -101,6 +101,9 @@ inline bool writeObjectToFileUsingId(const String &file, uint16_t id, const Json
 inline bool writeObjectToFile(const String &file, const char* key, const JsonDocument* content) { return writeObjectToFile(file.c_str(), key, content); };
 inline bool readObjectFromFileUsingId(const String &file, uint16_t id, JsonDocument* dest, const JsonDocument* filter = nullptr) { return readObjectFromFileUsingId(file.c_str(), id, dest); };
 inline bool readObjectFromFile(const String &file, const char* key, JsonDocument* dest, const JsonDocument* filter = nullptr) { return readObjectFromFile(file.c_str(), key, dest); };
+bool getPresetsFileStats(size_t &fileSize, size_t &freeBytes, size_t &largestFree);
+bool presetsNeedCompaction();
+bool compactPresetsFile();
 bool copyFile(const char* src_path, const char* dst_path);
 bool backupFile(const char* filename);
 bool restoreFile(const char* filename);
@@ -161,6 +164,9 @@ void serializeInfo(JsonObject root);
 void serializeModeNames(JsonArray arr);
 void serializeModeData(JsonArray fxdata);
 void serveJson(AsyncWebServerRequest* request);
+void handleJsonCache();
+void invalidateStaticJson();
+void freeStaticJson();
 #ifdef WLED_ENABLE_JSONLIVE
 bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient = 0);
 #endif
@@ -223,6 +229,7 @@ void initPresetsFile();
 void handlePresets();
 bool applyPreset(byte index, byte callMode = CALL_MODE_DIRECT_CHANGE);
 bool applyPresetFromPlaylist(byte index);
+bool prefetchPreset(byte index);
 void applyPresetWithFallback(uint8_t presetID, uint8_t callMode, uint8_t effectID = 0, uint8_t paletteID = 0);
 inline bool applyTemporaryPreset() {return applyPreset(255);};
 void savePreset(byte index, const char* pname = nullptr, JsonObject saveobj = JsonObject());
@@ -245,6 +252,7 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
+bool handleControlPacket(const uint8_t *data, size_t len, byte callMode = CALL_MODE_DIRECT_CHANGE);
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
 void refreshNodeList();
 void sendSysInfoUDP();
@@ -394,8 +402,21 @@ size_t printSetFormIndex(Print& settingsScript, const char* key, int index);
 size_t printSetClassElementHTML(Print& settingsScript, const char* key, const int index, const char* val);
 void prepareHostname(char* hostname);
 [[gnu::pure]] bool isAsterisksOnly(const char* str, byte maxLen);
-bool requestJSONBufferLock(uint8_t moduleID=255);
+bool requestJSONBufferLock(uint8_t moduleID=255, bool wait=true);
 void releaseJSONBufferLock();
+void initJSONDocumentPool();
+JsonDocument *requestJSONDocument(uint8_t moduleID=255, bool wait=true);
+void releaseJSONDocument(JsonDocument *doc);
+typedef struct JSONLockStats {
+  uint32_t requests;  // global buffer lock requests
+  uint32_t contended; // requests that found the buffer locked
+  uint32_t failed;    // requests that timed out
+  uint32_t waitTotal; // accumulated wait time (ms)
+  uint32_t waitMax;   // longest single wait (ms)
+  uint32_t leases;    // requests served from the document pool
+  uint8_t  poolSize;  // allocated pool documents
+} JSONLockStats;
+const JSONLockStats& getJSONLockStats();
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
@@ -418,6 +439,11 @@ uint16_t perlin16(uint32_t x, uint32_t y, uint32_t z);
 uint8_t perlin8(uint16_t x);
 uint8_t perlin8(uint16_t x, uint16_t y);
 uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z);
+// batch noise for a row of samples along x (x advances by dx per sample), same values as the single sample functions
+void perlin16Row(uint16_t *out, unsigned count, uint32_t x, uint32_t dx, uint32_t y);
+void perlin16Row(uint16_t *out, unsigned count, uint32_t x, uint32_t dx, uint32_t y, uint32_t z);
+void perlin8Row(uint8_t *out, unsigned count, uint16_t x, uint16_t dx, uint16_t y);
+void perlin8Row(uint8_t *out, unsigned count, uint16_t x, uint16_t dx, uint16_t y, uint16_t z);
 
 // fast (true) random numbers using hardware RNG, all functions return values in the range lowerlimit to upperlimit-1
 // note: for true random numbers with high entropy, do not call faster than every 200ns (5MHz)
@@ -10,6 +10,8 @@
 #endif
 #endif
 
+#include "preset_index.h"
+
 #define FS_BUFSIZE 256
 
 /*
@@ -161,12 +163,174 @@ static bool bufferedFindObjectEnd() {
   return false;
 }
 
+// In-RAM index of preset id -> file offset of its object (the '{' following "id":) in presets.json so that
+// loading a preset does not scan the file from the start. It is built in a single pass on first access,
+// kept up to date by writeObjectToFile() and rebuilt after any other write to presets.json (upload, /edit, restore,
+// compaction; all of them increment presetsModifiedCount) or if the file size changes.
+// Entries are verified against the key in front of the object before use.
+static uint32_t *presetIndex = nullptr; // 0 = no such preset (offset 0 is always the opening '{')
+static size_t    presetIndexFileSize = 0;
+static uint16_t  presetIndexModified = 0; // presetsModifiedCount the index is valid for
+static bool      fIndexed = false;      // f is presets.json
+
+// free space map of presets.json: runs of spaces left behind by replaced or deleted presets
+// maintained alongside preset index, replaces scanning the file in bufferedFindSpace()
+#define PRESET_FREE_EXTENTS 16 // largest holes tracked, smaller ones are only counted in presetFreeBytes
+#define PRESET_MIN_EXTENT    8 // smaller holes cannot hold a preset (,"1":{})
+#ifndef PRESETS_COMPACT_THRESHOLD
+#define PRESETS_COMPACT_THRESHOLD 25   // compact presets.json if more than this % of it is free space
+#endif
+#define PRESETS_COMPACT_MIN_FREE  2048 // ... and there are at least this many free bytes
+typedef struct {
+  uint32_t pos;
+  uint32_t len;
+} FileExtent;
+static FileExtent presetFree[PRESET_FREE_EXTENTS];
+static unsigned   presetFreeCount = 0;
+static size_t     presetFreeBytes = 0; // total, including untracked holes
+static bool       presetCompactFailed = false; // last compaction failed (i.e. not enough FS space), not retried until presets.json changes
+static uint16_t   presetCompactFailedCount = 0; // presetsModifiedCount at time of failure
+
+static inline bool isPresetsFile(const char *fileName) {
+  return strcmp_P(fileName, getPresetsFileName()) == 0;
+}
+
+static inline int keyToPresetId(const char *key) {
+  if (key == nullptr || key[0] != '"' || key[1] < '0' || key[1] > '9') return -1;
+  int id = atoi(key + 1);
+  return id < PRESET_INDEX_SIZE ? id : -1;
+}
+
+static void invalidatePresetIndex() {
+  d_free(presetIndex);
+  presetIndex = nullptr;
+  presetFreeCount = 0;
+  presetFreeBytes = 0;
+}
+
+static void removeFreeExtent(unsigned i) {
+  presetFree[i] = presetFree[--presetFreeCount];
+}
+
+//adds hole to free space map merging it with adjacent holes, does not update presetFreeBytes
+static void addFreeExtent(size_t pos, size_t len) {
+  for (int i = 0; i < (int)presetFreeCount; i++) {
+    if (presetFree[i].pos + presetFree[i].len == pos || pos + len == presetFree[i].pos) {
+      if (presetFree[i].pos < pos) pos = presetFree[i].pos;
+      len += presetFree[i].len;
+      removeFreeExtent(i);
+      i = -1; // restart as merged hole may now be adjacent to another one
+    }
+  }
+  if (len < PRESET_MIN_EXTENT) return;
+  unsigned smallest = 0;
+  if (presetFreeCount < PRESET_FREE_EXTENTS) smallest = presetFreeCount++;
+  else {
+    for (unsigned i = 1; i < presetFreeCount; i++) if (presetFree[i].len < presetFree[smallest].len) smallest = i;
+    if (presetFree[smallest].len >= len) return; // map is full of larger holes
+  }
+  presetFree[smallest] = {(uint32_t)pos, (uint32_t)len};
+}
+
+//marks used bytes at the start of a hole (file positon pos) as occupied
+static void useFreeExtent(size_t pos, size_t used) {
+  presetFreeBytes = presetFreeBytes > used ? presetFreeBytes - used : 0;
+  for (unsigned i = 0; i < presetFreeCount; i++) {
+    if (presetFree[i].pos != pos) continue;
+    if (presetFree[i].len < used + PRESET_MIN_EXTENT) removeFreeExtent(i);
+    else {
+      presetFree[i].pos += used;
+      presetFree[i].len -= used;
+    }
+    return;
+  }
+}
+
+//best fit hole from free space map (-1 if none)
+static int findFreeExtent(size_t len) {
+  int best = -1;
+  for (unsigned i = 0; i < presetFreeCount; i++) {
+    if (presetFree[i].len >= len && (best < 0 || presetFree[i].len < presetFree[best].len)) best = i;
+  }
+  return best;
+}
+
+//index all root level objects with numeric keys of the file opened in f
+static bool buildPresetIndex() {
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTLN(F("Build preset index"));
+    uint32_t s = millis();
+  #endif
+  if (!presetIndex) presetIndex = (uint32_t*)d_calloc(PRESET_INDEX_SIZE, sizeof(uint32_t));
+  if (!presetIndex) return false;
+  memset(presetIndex, 0, PRESET_INDEX_SIZE * sizeof(uint32_t));
+  presetFreeCount = 0;
+  presetFreeBytes = 0;
+
+  PresetIndexScan scan;
+  byte buf[FS_BUFSIZE];
+  f.seek(0);
+  while (scan.pos < f.size()) {
+    size_t bufsize = f.read(buf, FS_BUFSIZE);
+    if (!bufsize) break;
+    presetIndexScan(scan, buf, bufsize, presetIndex, [](size_t pos, size_t len) { addFreeExtent(pos, len); presetFreeBytes += len; });
+  }
+  presetIndexFileSize = f.size();
+  presetIndexModified = presetsModifiedCount;
+  DEBUGFS_PRINTF("Indexed, took %lu ms\n", millis() - s);
+  return true;
+}
+
+//positions f after the key (like bufferedFind()), uses preset index if f is presets.json
+static bool findObject(const char *key) {
+  int id = keyToPresetId(key);
+  if (!fIndexed || id < 0) return bufferedFind(key);
+
+  if (!presetIndex || presetIndexFileSize != f.size() || presetIndexModified != presetsModifiedCount) {
+    if (!buildPresetIndex()) return bufferedFind(key);
+  }
+  size_t pos = presetIndex[id];
+  if (pos == 0) return false; // no such object in file
+
+  char buf[10]; // same size as objKey in *UsingId() functions
+  size_t keyLen = strlen(key);
+  if (pos >= keyLen && keyLen <= sizeof(buf)) {
+    f.seek(pos - keyLen);
+    if (f.read((byte*)buf, keyLen) == keyLen && memcmp(buf, key, keyLen) == 0) return true; // f is at '{'
+  }
+  DEBUGFS_PRINTLN(F("Stale preset index."));
+  invalidatePresetIndex(); // file was modified elsewhere, rebuild on next access
+  return bufferedFind(key);
+}
+
+//call after writing object with key at pos (0 if deleted), f must be positioned after last written byte
+static void updatePresetIndex(const char *key, size_t pos) {
+  int id = keyToPresetId(key);
+  if (!fIndexed || !presetIndex || id < 0) return;
+  presetIndex[id] = pos;
+  if (f.position() > presetIndexFileSize) presetIndexFileSize = f.position(); // appended at the end
+}
+
+//finds space for len bytes and positions f at its start, uses free space map if f is presets.json
+static bool findSpace(size_t len) {
+  if (!fIndexed || !presetIndex) return bufferedFindSpace(len);
+  int i = findFreeExtent(len);
+  if (i < 0) return false;
+  f.seek(presetFree[i].pos);
+  return true;
+}
+
 //fills n bytes from current file pos with ' ' characters
 static void writeSpace(size_t l)
 {
   byte buf[FS_BUFSIZE];
   memset(buf, ' ', FS_BUFSIZE);
 
+  if (fIndexed && presetIndex) {
+    addFreeExtent(f.position(), l);
+    presetFreeBytes += l;
+  }
+
   while (l > 0) {
     size_t block = (l>FS_BUFSIZE) ? FS_BUFSIZE : l;
     f.write(buf, block);
@@ -199,10 +363,14 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   //if there is enough empty space in file, insert there instead of appending
   if (!contentLen) contentLen = measureJson(*content);
   DEBUGFS_PRINTF("CLen %d\n", contentLen);
-  if (bufferedFindSpace(contentLen + strlen(key) + 1)) {
-    if (f.position() > 2) f.write(','); //add comma if not first object
+  if (findSpace(contentLen + strlen(key) + 1)) {
+    size_t start = f.position();
+    if (start > 2) f.write(','); //add comma if not first object
     f.print(key);
+    pos = f.position();
     serializeJson(*content, f);
+    updatePresetIndex(key, pos);
+    if (fIndexed) useFreeExtent(start, f.position() - start);
     DEBUGFS_PRINTF("Inserted, took %lu ms (total %lu)", millis() - s1, millis() - s);
     doCloseFile = true;
     return true;
@@ -212,6 +380,10 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
 
   //permitted space for presets exceeded
   updateFSInfo();
+  if (f.size() + 9000 > (fsBytesTotal - fsBytesUsed)) { // generated JSON files are only a cache, presets take precedence
+    freeStaticJson();
+    updateFSInfo();
+  }
 
   if (f.size() + 9000 > (fsBytesTotal - fsBytesUsed)) { //make sure there is enough space to at least copy the file once
     errorFlag = ERR_FS_QUOTA;
@@ -245,10 +417,12 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   }
 
   f.print(key);
+  pos = f.position();
 
   //Append object
   serializeJson(*content, f);
   f.write('}');
+  updatePresetIndex(key, pos);
 
   doCloseFile = true;
   DEBUGFS_PRINTF("Appended, took %lu ms (total %lu)", millis() - s1, millis() - s);
@@ -278,8 +452,14 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     DEBUGFS_PRINTLN(F("Failed to open!"));
     return false;
   }
+  fIndexed = isPresetsFile(fileName);
+  if (fIndexed) {
+    const bool indexValid = presetIndexModified == presetsModifiedCount;
+    presetsModifiedCount++;
+    if (indexValid) presetIndexModified = presetsModifiedCount; // index is updated along with our own write
+  }
 
-  if (!bufferedFind(key)) //key does not exist in file
+  if (!findObject(key)) //key does not exist in file
   {
     return appendObjectToFile(key, content, s);
   }
@@ -307,16 +487,20 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     f.seek(pos);
     serializeJson(*content, f);
     writeSpace(pos2 - f.position());
+    updatePresetIndex(key, pos);
   } else if (contentLen && bufferedFindSpace(contentLen - oldLen, false)) { //enough leading spaces to replace
     DEBUGFS_PRINTLN(F("replace (trailing)"));
     f.seek(pos);
     serializeJson(*content, f);
+    updatePresetIndex(key, pos);
+    if (fIndexed) useFreeExtent(pos2, f.position() - pos2);
   } else {
     DEBUGFS_PRINTLN(F("delete"));
     pos -= strlen(key);
     if (pos > 3) pos--; //also delete leading comma if not first object
     f.seek(pos);
     writeSpace(pos2 - pos);
+    updatePresetIndex(key, 0);
     if (contentLen) return appendObjectToFile(key, content, s, contentLen);
   }
 
@@ -343,8 +527,9 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, c
   char fileName[129]; strncpy_P(fileName, file, 128); fileName[128] = 0; //use PROGMEM safe copy as FS.open() does not
   f = WLED_FS.open(fileName, "r");
   if (!f) return false;
+  fIndexed = isPresetsFile(fileName);
 
-  if (key != nullptr && !bufferedFind(key)) //key does not exist in file
+  if (key != nullptr && !findObject(key)) //key does not exist in file
   {
     f.close();
     dest->clear();
@@ -360,6 +545,86 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, c
   return true;
 }
 
+//returns false if presets.json has not been indexed yet
+bool getPresetsFileStats(size_t &fileSize, size_t &freeBytes, size_t &largestFree) {
+  if (!presetIndex) return false;
+  fileSize = presetIndexFileSize;
+  freeBytes = presetFreeBytes;
+  largestFree = 0;
+  for (unsigned i = 0; i < presetFreeCount; i++) if (presetFree[i].len > largestFree) largestFree = presetFree[i].len;
+  return true;
+}
+
+bool presetsNeedCompaction() {
+  if (presetCompactFailed && presetCompactFailedCount == presetsModifiedCount) return false; // back off after failure
+  return presetIndex && presetFreeBytes >= PRESETS_COMPACT_MIN_FREE && presetFreeBytes * 100 > presetIndexFileSize * PRESETS_COMPACT_THRESHOLD;
+}
+
+// remember failed compaction so that it is not retried on every loop() until presets.json changes again
+static void compactFailed() {
+  presetCompactFailed = true;
+  presetCompactFailedCount = presetsModifiedCount;
+}
+
+//rewrites presets.json without whitespace: backup first, write compacted copy, validate it and copy it over the original
+bool compactPresetsFile() {
+  if (doCloseFile) closeFile();
+  char fileName[33]; strncpy_P(fileName, getPresetsFileName(), 32); fileName[32] = 0; //use PROGMEM safe copy as FS.open() does not
+  static const char tmpName[] = "/pcmp.json";
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTF("Compacting %s (%u of %u bytes free)\n", fileName, presetFreeBytes, presetIndexFileSize);
+    uint32_t s = millis();
+  #endif
+
+  updateFSInfo();
+  if (presetIndexFileSize * 2 + 4096 > fsBytesTotal - fsBytesUsed) { // generated JSON files are only a cache
+    freeStaticJson();
+    updateFSInfo();
+  }
+  if (presetIndexFileSize * 2 + 4096 > fsBytesTotal - fsBytesUsed || !backupFile(fileName)) { // need room for backup and compacted copy
+    compactFailed();
+    return false;
+  }
+
+  File src = WLED_FS.open(fileName, "r");
+  File dst = WLED_FS.open(tmpName, "w");
+  bool success = src && dst;
+  if (success) {
+    bool inStr = false, esc = false;
+    byte in[FS_BUFSIZE], out[FS_BUFSIZE];
+    size_t bufsize;
+    while (success && (bufsize = src.read(in, FS_BUFSIZE)) > 0) {
+      size_t n = 0;
+      for (size_t i = 0; i < bufsize; i++) {
+        char c = in[i];
+        if (inStr) {
+          if (esc) esc = false;
+          else if (c == '\\') esc = true;
+          else if (c == '"') inStr = false;
+        } else if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue; // drop whitespace outside strings
+        else if (c == '"') inStr = true;
+        out[n++] = c;
+      }
+      success = dst.write(out, n) == n;
+    }
+  }
+  if (src) src.close();
+  if (dst) dst.close();
+
+  success = success && validateJsonFile(tmpName);
+  if (success) {
+    success = copyFile(tmpName, fileName);
+    if (!success) restoreFile(fileName);
+  }
+  WLED_FS.remove(tmpName);
+  invalidatePresetIndex(); // rebuilt on next access
+  updateFSInfo();
+  DEBUGFS_PRINTF("Compaction %s, took %lu ms\n", success ? "done" : "failed", millis() - s);
+  if (success) presetCompactFailed = false;
+  else         compactFailed();
+  return success;
+}
+
 void updateFSInfo() {
   #ifdef ARDUINO_ARCH_ESP32
     #if WLED_FS == LITTLEFS || ESP_IDF_VERSION_MAJOR >= 4
@@ -449,6 +714,10 @@ bool copyFile(const char* src_path, const char* dst_path) {
   }
 
   bool success = true; // is set to false on error
+  if (isPresetsFile(dst_path)) {
+    invalidatePresetIndex();
+    presetsModifiedCount++;
+  }
   File src = WLED_FS.open(src_path, "r");
   File dst = WLED_FS.open(dst_path, "w");
 
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef WLED_FX_JULIA_H
+#define WLED_FX_JULIA_H
+/*
+ * Per pixel iteration of the Julia effect (mode_2DJulia()) in floating point and in fixed point (WLED_FX_FIXEDPOINT)
+ * kept free of Arduino dependencies so both can be compared and benchmarked on the host (tools/fx_fixedpoint_test.cpp)
+ */
+#include <stdint.h>
+
+#define JULIA_Q 24 // fixed point fraction bits
+
+// number of iterations of z -> z^2 + c (z = a+ib, c = re+i*im) until |z|^2 exceeds maxCalc, maxIterations if it never does
+// F is float on the device, the host benchmark also uses a software float type
+template<class F>
+static inline int juliaIterations(F a, F b, const F re, const F im, const int maxIterations, const F maxCalc) {
+  int iter = 0;
+  while (iter < maxIterations) {    // Here we determine whether or not we're out of bounds.
+    F aa = a * a;
+    F bb = b * b;
+    F len = aa + bb;
+    if (len > maxCalc) {            // |z| = sqrt(a^2+b^2) OR z^2 = a^2+b^2 to save on having to perform a square root.
+      break;  // Bail
+    }
+    // This operation corresponds to z -> z^2+c where z=a+ib c=(x,y). Remember to use 'foil'.
+    b = F(2)*a*b + im;
+    a = aa - bb + re;
+    iter++;
+  }
+  return iter;
+}
+
+// fixed point version: values are in Q24 with 64 bit products (Q13 with 32 bit products is too coarse when zoomed in as the
+// set is chaotic near its border). |z| is at most 4 before bailing out so values fit 32 bits, maxCalcQ is maxCalc in Q48
+static inline int juliaIterationsQ(int32_t a, int32_t b, const int32_t reQ, const int32_t imQ, const int maxIterations, const int64_t maxCalcQ) {
+  constexpr int32_t limitQ = 4 << JULIA_Q; // |a| or |b| > 4 means a^2+b^2 > maxCalc
+  int iter = 0;
+  while (iter < maxIterations) {
+    if (a > limitQ || a < -limitQ || b > limitQ || b < -limitQ) break; // also keeps the values below from overflowing
+    int64_t aa = (int64_t)a * a;
+    int64_t bb = (int64_t)b * b;
+    if (aa + bb > maxCalcQ) break;
+    b = (int32_t)((((int64_t)a * b) >> (JULIA_Q - 1)) + imQ); // 2*a*b
+    a = (int32_t)(((aa - bb) >> JULIA_Q) + reQ);
+    iter++;
+  }
+  return iter;
+}
+
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+#ifndef WLED_FX_LIFE_H
+#define WLED_FX_LIFE_H
+/*
+ * Bit sliced neighbour count of the Game of Life effect (mode_2Dgameoflife())
+ * cells are one bit each, rows padded to 32 bit words, the grid wraps around at the edges (lastWord/lastBit: last cell of a row)
+ * kept free of Arduino dependencies so it can be verified and benchmarked on the host (tools/fx_life_test.cpp)
+ */
+#include <stdint.h>
+
+// west (x-1) neighbour bits shifted into the position of the cells of word w
+static inline uint32_t lifeWestOf(const uint32_t *row, unsigned w, unsigned lastWord, unsigned lastBit) {
+  return (row[w] << 1) | (w ? row[w-1] >> 31 : (row[lastWord] >> lastBit) & 1);
+}
+
+// east (x+1) neighbour bits shifted into the position of the cells of word w
+static inline uint32_t lifeEastOf(const uint32_t *row, unsigned w, unsigned lastWord, unsigned lastBit) {
+  return (row[w] >> 1) | (w < lastWord ? row[w+1] << 31 : (row[0] & 1) << lastBit);
+}
+
+// counts alive neighbours of the 32 cells in word w of rowC (rowN/rowS: rows above and below) at once,
+// two/three get the cells with exactly two/three alive neighbours
+static inline void lifeNeighbourCount(const uint32_t *rowN, const uint32_t *rowC, const uint32_t *rowS, unsigned w,
+                                      unsigned lastWord, unsigned lastBit, uint32_t &two, uint32_t &three) {
+  const uint32_t neighbours[8] = {
+    lifeWestOf(rowN, w, lastWord, lastBit), rowN[w], lifeEastOf(rowN, w, lastWord, lastBit),
+    lifeWestOf(rowC, w, lastWord, lastBit),          lifeEastOf(rowC, w, lastWord, lastBit),
+    lifeWestOf(rowS, w, lastWord, lastBit), rowS[w], lifeEastOf(rowS, w, lastWord, lastBit)
+  };
+  // bit sliced adder, count is s3 s2 s1 s0
+  uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  for (uint32_t n : neighbours) {
+    uint32_t c0 = s0 & n;  s0 ^= n;
+    uint32_t c1 = s1 & c0; s1 ^= c0;
+    uint32_t c2 = s2 & c1; s2 ^= c1;
+    s3 |= c2;
+  }
+  three = s0 & s1 & ~s2 & ~s3;
+  two   = ~s0 & s1 & ~s2 & ~s3;
+}
+
+#endif
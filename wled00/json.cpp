@@ -1,4 +1,5 @@
 #include "wled.h"
+#include "FXparticleSystem.h"
 
 #define JSON_PATH_STATE      1
 #define JSON_PATH_INFO       2
@@ -687,6 +688,8 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
   }
 }
 
+static size_t jsonStreamHeapPeak = 0; // largest heap drop seen while streaming a full /json response (see serveJsonStream())
+
 void serializeInfo(JsonObject root)
 {
   root[F("ver")] = versionString;
@@ -699,6 +702,7 @@ void serializeInfo(JsonObject root)
   leds[F("count")] = strip.getLengthTotal();
   leds[F("pwr")] = BusManager::currentMilliamps();
   leds["fps"] = strip.getFps();
+  if (strip.adaptiveQuality) leds["q"] = strip.getQualityLevel();
   leds[F("maxpwr")] = BusManager::currentMilliamps()>0 ? BusManager::ablMilliampsMax() : 0;
   leds[F("maxseg")] = WS2812FX::getMaxSegments();
   //leds[F("actseg")] = strip.getActiveSegmentsNum();
@@ -795,6 +799,35 @@ void serializeInfo(JsonObject root)
   fs_info["u"] = fsBytesUsed / 1000;
   fs_info["t"] = fsBytesTotal / 1000;
   fs_info[F("pmt")] = presetsModifiedTime;
+  size_t pSize, pFree, pLargest;
+  if (getPresetsFileStats(pSize, pFree, pLargest)) { // presets.json fragmentation (only known once it has been indexed)
+    fs_info[F("pfree")] = pFree;
+    fs_info[F("pfrag")] = pSize ? (pFree * 100) / pSize : 0; // %
+    fs_info[F("phole")] = pLargest;
+  }
+
+  const JSONLockStats& jls = getJSONLockStats();
+  JsonObject jbuf_info = root.createNestedObject(F("jbuf"));
+  jbuf_info[F("req")]   = jls.requests;
+  jbuf_info[F("wait")]  = jls.contended;
+  jbuf_info[F("fail")]  = jls.failed;
+  jbuf_info[F("tavg")]  = jls.contended ? jls.waitTotal / jls.contended : 0; // ms
+  jbuf_info[F("tmax")]  = jls.waitMax;  // ms
+  jbuf_info[F("pool")]  = jls.poolSize;
+  jbuf_info[F("lease")] = jls.leases;
+  jbuf_info[F("speak")] = jsonStreamHeapPeak; // bytes
+
+#if !(defined(WLED_DISABLE_PARTICLESYSTEM2D) && defined(WLED_DISABLE_PARTICLESYSTEM1D))
+  JsonArray ps_info = root.createNestedArray(F("psmem")); // particle system memory per segment
+  for (unsigned i = 0; i < strip.getSegmentsNum(); i++) {
+    uint32_t particles = getParticleCount(i);
+    if (particles == 0) continue;
+    JsonObject ps = ps_info.createNestedObject();
+    ps["id"]     = i;
+    ps[F("mem")] = strip.getSegment(i).dataSize();
+    ps["n"]      = particles;
+  }
+#endif
 
   root[F("ndc")] = nodeListEnabled ? (int)Nodes.size() : -1;
 
@@ -924,19 +957,25 @@ void setPaletteColors(JsonArray json, byte* tcp)
     }
 }
 
+#ifdef ESP8266
+  #define PALETTES_PER_PAGE 5
+#else
+  #define PALETTES_PER_PAGE 8
+#endif
+
+static int getPalettesMaxPage() {
+  return (getPaletteCount() - 1) / PALETTES_PER_PAGE;
+}
+
 void serializePalettes(JsonObject root, int page)
 {
   byte tcp[72];
-  #ifdef ESP8266
-  int itemPerPage = 5;
-  #else
-  int itemPerPage = 8;
-  #endif
+  int itemPerPage = PALETTES_PER_PAGE;
 
   int customPalettesCount = customPalettes.size();
   int palettesCount = getPaletteCount() - customPalettesCount; // palettesCount is number of palettes, not palette index
 
-  int maxPage = (palettesCount + customPalettesCount -1) / itemPerPage;
+  int maxPage = getPalettesMaxPage();
   if (page > maxPage) page = maxPage;
 
   int start = itemPerPage * page;
@@ -1069,28 +1108,474 @@ void serializeModeNames(JsonArray arr)
 
 // Global buffer locking response helper class (to make sure lock is released when AsyncJsonResponse is destroyed)
 class LockedJsonResponse: public AsyncJsonResponse {
-  bool _holding_lock;
+  JsonDocument *_lease;
   public:
-  // WARNING: constructor assumes requestJSONBufferLock() was successfully acquired externally/prior to constructing the instance
+  // WARNING: constructor assumes the document was successfully leased (requestJSONDocument()) externally/prior to constructing the instance
   // Not a good practice with C++. Unfortunately AsyncJsonResponse only has 2 constructors - for dynamic buffer or existing buffer,
   // with existing buffer it clears its content during construction
   // if the lock was not acquired (using JSONBufferGuard class) previous implementation still cleared existing buffer
-  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _holding_lock(true) {};
+  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _lease(doc) {};
 
   virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) { 
     size_t result = AsyncJsonResponse::_fillBuffer(buf, maxLen);
-    // Release lock as soon as we're done filling content
-    if (((result + _sentLength) >= (_contentLength)) && _holding_lock) {
-      releaseJSONBufferLock();
-      _holding_lock = false;
+    // Release lease as soon as we're done filling content
+    if (((result + _sentLength) >= (_contentLength)) && _lease) {
+      releaseJSONDocument(_lease);
+      _lease = nullptr;
     }
     return result;
   }
 
-  // destructor will remove JSON buffer lock when response is destroyed in AsyncWebServer
-  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
+  // destructor will return JSON document (or buffer lock) when response is destroyed in AsyncWebServer
+  virtual ~LockedJsonResponse() { if (_lease) releaseJSONDocument(_lease); };
 };
 
+// pre-serialized /json/fxdata, /json/eff and /json/palx responses stored in FS
+// content only depends on firmware, registered (usermod) effects and custom palettes: a file is generated from loop()
+// (see generateStaticJson()) after the first request since any of these changed and then streamed from FS without
+// JSON buffer or CPU cost; until it is ready requests are serialized dynamically
+// the files are only a cache and are removed as soon as presets need the space (see freeStaticJson())
+#define STATIC_JSON_KEY_FILE  "/jc.key"
+#define STATIC_JSON_FXDATA    "/jc_fx.json"
+#define STATIC_JSON_EFFECTS   "/jc_eff.json"
+#define STATIC_JSON_PALETTES  "/jc_pal%d.json"
+#define STATIC_JSON_MAX_PAGES ((255 + PALETTES_PER_PAGE - 1) / PALETTES_PER_PAGE)
+// file IDs (bit in the masks below, also part of the ETag)
+#define STATIC_JSON_ID_FXDATA   0
+#define STATIC_JSON_ID_EFFECTS  1
+#define STATIC_JSON_ID_PALETTES 2 // + page
+
+static uint32_t staticJsonKey = 0;              // 0 = needs validation
+static volatile uint64_t staticJsonReady   = 0; // files that exist and match staticJsonKey
+static volatile uint64_t staticJsonPending = 0; // files requested since they are not ready (set by request handlers)
+static uint64_t staticJsonFailed = 0;           // files that could not be written, not retried until revalidated
+
+static uint32_t fnv1a(uint32_t hash, const uint8_t *data, size_t len, bool progmem = false) {
+  for (size_t i = 0; i < len; i++) {
+    hash ^= progmem ? pgm_read_byte(data + i) : data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+// called when custom palettes are (re)loaded
+void invalidateStaticJson() {
+  staticJsonKey = 0;
+}
+
+static void getStaticJsonFileName(char *fileName, unsigned id) {
+  if      (id == STATIC_JSON_ID_FXDATA)  strcpy_P(fileName, PSTR(STATIC_JSON_FXDATA));
+  else if (id == STATIC_JSON_ID_EFFECTS) strcpy_P(fileName, PSTR(STATIC_JSON_EFFECTS));
+  else                                   sprintf_P(fileName, PSTR(STATIC_JSON_PALETTES), id - STATIC_JSON_ID_PALETTES);
+}
+
+static void removeStaticJsonFiles() {
+  char fileName[24];
+  staticJsonReady = 0; // before removing so that no new response is started for a removed file
+  for (unsigned id = 0; id < STATIC_JSON_ID_PALETTES + STATIC_JSON_MAX_PAGES; id++) {
+    getStaticJsonFileName(fileName, id);
+    if (WLED_FS.exists(fileName)) WLED_FS.remove(fileName);
+  }
+}
+
+// compare content key of stored files with current firmware/effects/palettes and remove stale files
+static void validateStaticJson() {
+  if (staticJsonKey) return;
+  uint32_t key = 2166136261UL;
+  uint32_t version = VERSION;
+  key = fnv1a(key, (const uint8_t*)&version, sizeof(version));
+  for (size_t i = 0; i < strip.getModeCount(); i++) {
+    const char *data = strip.getModeData(i);
+    key = fnv1a(key, (const uint8_t*)data, strlen_P(data) + 1, true);
+  }
+  for (const auto &pal : customPalettes) key = fnv1a(key, (const uint8_t*)&pal, sizeof(pal));
+  if (!key) key = 1;
+
+  char keyStr[12];
+  sprintf_P(keyStr, PSTR("%08x"), key);
+  bool stale = true;
+  File f = WLED_FS.open(STATIC_JSON_KEY_FILE, "r");
+  if (f) {
+    stale = f.readString() != keyStr;
+    f.close();
+  }
+  if (stale) {
+    DEBUG_PRINTF_P(PSTR("Static JSON key changed: %s\n"), keyStr);
+    removeStaticJsonFiles();
+    f = WLED_FS.open(STATIC_JSON_KEY_FILE, "w");
+    if (!f) return; // FS unavailable, try again next time
+    f.print(keyStr);
+    f.close();
+  }
+  staticJsonFailed = 0;
+  staticJsonKey = key;
+}
+
+// writes one requested file per call (called from loop() so that request handlers do not access FS for writing)
+static void generateStaticJson() {
+  if (!staticJsonPending || strip.isUpdating()) return; // accessing FS during sendout causes glitches
+  validateStaticJson();
+  if (!staticJsonKey) return;
+
+  unsigned id = 0;
+  while (!(staticJsonPending & (1ULL << id))) id++;
+  uint64_t bit = 1ULL << id;
+  staticJsonPending &= ~bit;
+  if ((staticJsonReady | staticJsonFailed) & bit) return;
+
+  char fileName[24];
+  getStaticJsonFileName(fileName, id);
+  if (WLED_FS.exists(fileName)) { // generated before reboot
+    staticJsonReady |= bit;
+    return;
+  }
+  JsonDocument *doc = requestJSONDocument(17);
+  if (!doc) {
+    staticJsonPending |= bit; // retry
+    return;
+  }
+  if      (id == STATIC_JSON_ID_FXDATA)  serializeModeData(doc->to<JsonArray>());
+  else if (id == STATIC_JSON_ID_EFFECTS) serializeModeNames(doc->to<JsonArray>());
+  else                                   serializePalettes(doc->to<JsonObject>(), id - STATIC_JSON_ID_PALETTES);
+  size_t len = measureJson(*doc);
+  size_t written = 0;
+  updateFSInfo();
+  if (len + 9000 < fsBytesTotal - fsBytesUsed) { // leave space for presets (same margin as writeObjectToFile())
+    File f = WLED_FS.open(fileName, "w");
+    if (f) {
+      written = serializeJson(*doc, f);
+      f.close();
+    }
+  }
+  releaseJSONDocument(doc);
+  if (written != len) {
+    DEBUG_PRINTF_P(PSTR("Static JSON write failed: %s\n"), fileName);
+    if (WLED_FS.exists(fileName)) WLED_FS.remove(fileName);
+    staticJsonFailed |= bit;
+    return;
+  }
+  DEBUG_PRINTF_P(PSTR("Static JSON %s generated: %u bytes\n"), fileName, len);
+  updateFSInfo();
+  staticJsonReady |= bit;
+}
+
+// removes generated files to make room for presets or config, they are not generated again until revalidated
+void freeStaticJson() {
+  removeStaticJsonFiles();
+  staticJsonFailed = ~0ULL;
+  DEBUG_PRINTLN(F("Static JSON files removed."));
+}
+
+// returns false if the response could not be served from FS (caller should serialize it dynamically)
+static bool serveStaticJson(AsyncWebServerRequest* request, unsigned id) {
+  uint64_t bit = 1ULL << id;
+  if (!staticJsonKey || !(staticJsonReady & bit)) {
+    if (!(staticJsonFailed & bit)) staticJsonPending |= bit; // generate from loop()
+    return false;
+  }
+
+  char etag[24];
+  sprintf_P(etag, PSTR("\"%08x-%u\""), staticJsonKey, id);
+  AsyncWebHeader *header = request->getHeader(F("If-None-Match"));
+  if (header && header->value() == etag) {
+    AsyncWebServerResponse *response = request->beginResponse(304);
+    response->addHeader(F("Cache-Control"), F("no-cache"));
+    response->addHeader(F("ETag"), etag);
+    request->send(response);
+    return true;
+  }
+
+  char fileName[24];
+  getStaticJsonFileName(fileName, id);
+  AsyncWebServerResponse *response = request->beginResponse(WLED_FS, fileName, FPSTR(CONTENT_TYPE_JSON));
+  response->addHeader(F("Cache-Control"), F("no-cache"));
+  response->addHeader(F("ETag"), etag);
+  request->send(response);
+  return true;
+}
+
+// cached serialization of /json/state, /json/info and /json/si (dashboards poll these every second or so)
+// state is reused while stateVersion is unchanged; info contains live values (uptime, heap, fps) and is only reused briefly
+// an outdated body is still a consistent snapshot: it is served instead of waiting while another task holds the JSON
+// buffer lock (preset being loaded, API call), so readers do not queue up behind writers
+// bodies are dropped from heap once their TTL is over (see handleJsonCache()); ESP8266 does not keep them at all
+#ifndef WLED_JSON_CACHE
+  #ifdef ESP8266
+    #define WLED_JSON_CACHE 0
+  #else
+    #define WLED_JSON_CACHE 1
+  #endif
+#endif
+#ifndef WLED_JSON_STATE_CACHE_TTL
+  #define WLED_JSON_STATE_CACHE_TTL 10000 // ms, upper bound for state changes that bypass stateUpdated() (i.e. usermods)
+#endif
+#ifndef WLED_JSON_INFO_CACHE_TTL
+  #define WLED_JSON_INFO_CACHE_TTL 1000   // ms
+#endif
+#define JSON_CACHE_STATE      0
+#define JSON_CACHE_INFO       1
+#define JSON_CACHE_STATE_INFO 2
+
+namespace {
+  typedef struct {
+    std::shared_ptr<String> body; // shared with responses still being sent
+    uint32_t version;             // stateVersion at serialization
+    unsigned long time;
+    uint32_t tag;                 // ETag value (hash of body)
+    bool valid;
+  } JsonCacheEntry;
+  JsonCacheEntry jsonCache[3];
+  uint32_t jsonCacheSalt = 0;
+  #if WLED_JSON_CACHE && defined(ARDUINO_ARCH_ESP32)
+  portMUX_TYPE jsonCacheMux = portMUX_INITIALIZER_UNLOCKED; // entries are expired from loop() and used from async_tcp task
+  #endif
+}
+
+#if WLED_JSON_CACHE && defined(ARDUINO_ARCH_ESP32)
+  #define JSON_CACHE_LOCK()   portENTER_CRITICAL(&jsonCacheMux)
+  #define JSON_CACHE_UNLOCK() portEXIT_CRITICAL(&jsonCacheMux)
+#else
+  #define JSON_CACHE_LOCK()
+  #define JSON_CACHE_UNLOCK()
+#endif
+
+static bool isJsonCacheExpired(const JsonCacheEntry &c, unsigned idx) {
+  return !c.body || millis() - c.time >= (idx != JSON_CACHE_STATE ? WLED_JSON_INFO_CACHE_TTL : WLED_JSON_STATE_CACHE_TTL);
+}
+
+static bool isJsonCacheValid(const JsonCacheEntry &c, unsigned idx) {
+  if (!c.valid || isJsonCacheExpired(c, idx)) return false;
+  return idx == JSON_CACHE_INFO || c.version == stateVersion;
+}
+
+// returns (cached or freshly serialized) body and its ETag value, false if JSON buffer or memory is unavailable
+static bool getJsonCache(unsigned idx, std::shared_ptr<String> &body, uint32_t &tag) {
+  JsonCacheEntry &c = jsonCache[idx];
+  bool hasState = idx != JSON_CACHE_INFO;
+
+  JSON_CACHE_LOCK();
+  bool valid = isJsonCacheValid(c, idx);
+  if (valid) {
+    body = c.body; // keeps content alive until sent even if the entry is updated or expired meanwhile
+    tag  = c.tag;
+  }
+  JSON_CACHE_UNLOCK();
+  if (valid) return true;
+
+  JsonDocument *doc = requestJSONDocument(17, false);
+  if (!doc) { // state is being modified by another task: serve previous snapshot if there is one, otherwise wait
+    JSON_CACHE_LOCK();
+    bool snapshot = !isJsonCacheExpired(c, idx);
+    if (snapshot) {
+      body = c.body;
+      tag  = c.tag;
+    }
+    JSON_CACHE_UNLOCK();
+    if (snapshot) return true;
+    doc = requestJSONDocument(17);
+    if (!doc) return false;
+  }
+  uint32_t version = stateVersion; // capture before serializing so a concurrent update invalidates the result
+  // error is reported only once and nightlight countdown changes every second, do not keep such state
+  bool cacheable = !hasState || (errorFlag == ERR_NONE && !nightlightActive);
+  JsonObject root = doc->to<JsonObject>();
+  if (idx == JSON_CACHE_STATE_INFO) {
+    JsonObject state = root.createNestedObject("state");
+    serializeState(state);
+    JsonObject info = root.createNestedObject("info");
+    serializeInfo(info);
+  } else if (hasState) serializeState(root);
+  else                 serializeInfo(root);
+  body = std::make_shared<String>();
+  size_t len = measureJson(*doc);
+  if (body->reserve(len + 1)) serializeJson(*doc, *body);
+  releaseJSONDocument(doc);
+  if (body->length() != len) {
+    DEBUG_PRINTLN(F("JSON cache allocation failed."));
+    body.reset();
+    return false;
+  }
+  // ETag is derived from content: unchanged data keeps its tag (and 304 response) even if it was serialized again
+  if (!jsonCacheSalt) jsonCacheSalt = hw_random() | 1; // do not reuse ETags of a previous boot
+  tag = fnv1a(jsonCacheSalt, (const uint8_t*)body->c_str(), len);
+  #if WLED_JSON_CACHE
+  std::shared_ptr<String> old = body;
+  JSON_CACHE_LOCK();
+  c.body.swap(old);  // previous body is released outside of critical section
+  c.version = version;
+  c.time    = millis();
+  c.tag     = tag;
+  c.valid   = cacheable;
+  JSON_CACHE_UNLOCK();
+  DEBUG_PRINTF_P(PSTR("JSON cache %u updated: %u bytes\n"), idx, len);
+  #else
+  (void)version; (void)cacheable;
+  #endif
+  return true;
+}
+
+// drops bodies past their TTL so they do not occupy heap while nobody is polling and writes requested static JSON files
+// (called from loop())
+void handleJsonCache() {
+  generateStaticJson();
+  #if WLED_JSON_CACHE
+  for (unsigned idx = 0; idx < 3; idx++) {
+    std::shared_ptr<String> old;
+    JSON_CACHE_LOCK();
+    if (jsonCache[idx].body && isJsonCacheExpired(jsonCache[idx], idx)) old.swap(jsonCache[idx].body);
+    JSON_CACHE_UNLOCK();
+    if (old) DEBUG_PRINTF_P(PSTR("JSON cache %u expired.\n"), idx);
+  }
+  #endif
+}
+
+// returns false if the request has not been answered (caller should defer it)
+static bool serveCachedJson(AsyncWebServerRequest* request, unsigned idx) {
+  std::shared_ptr<String> body;
+  uint32_t tag;
+  if (!getJsonCache(idx, body, tag)) return false;
+
+  char etag[20];
+  sprintf_P(etag, PSTR("\"%08x\""), tag);
+  AsyncWebHeader *header = request->getHeader(F("If-None-Match"));
+  AsyncWebServerResponse *response;
+  if (header && header->value() == etag) {
+    response = request->beginResponse(304);
+  } else {
+    response = request->beginResponse(FPSTR(CONTENT_TYPE_JSON), body->length(),
+      [body](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+        size_t len = std::min(maxLen, (size_t)(body->length() - index));
+        memcpy(buffer, body->c_str() + index, len);
+        return len;
+      });
+  }
+  response->addHeader(F("Cache-Control"), F("no-cache")); // always revalidate
+  response->addHeader(F("ETag"), etag);
+  request->send(response);
+  return true;
+}
+
+// full /json response is streamed in sections instead of being built in a JsonDocument:
+// cached state+info text, effect names (directly from mode data) and palette names (from flash)
+#define JSON_STREAM_OPEN     0
+#define JSON_STREAM_SI       1
+#define JSON_STREAM_FX_OPEN  2
+#define JSON_STREAM_FX       3
+#define JSON_STREAM_PAL_OPEN 4
+#define JSON_STREAM_PAL      5
+#define JSON_STREAM_CLOSE    6
+#define JSON_STREAM_END      7
+
+namespace {
+  typedef struct {
+    std::shared_ptr<String> si; // cached {"state":{..},"info":{..}}
+    String fxChunk;             // batch of effect names
+    const char *src;            // current section data
+    size_t srcLen;
+    size_t srcPos;
+    bool progmem;
+    bool fxFirst;               // no effect name added yet (empty names are skipped)
+    uint8_t section;
+    uint8_t fx;                 // next effect to add to fxChunk
+    size_t startHeap;           // free heap when stream was started
+    size_t minHeap;             // lowest free heap seen while streaming (reported as jbuf.speak in info)
+  } JsonStream;
+}
+
+// appends str as quoted JSON string, escaping quotes, backslash and all control characters
+static void appendJsonString(String &dest, const char *str) {
+  dest += '"';
+  for (const char *c = str; *c; c++) {
+    switch (*c) {
+      case '"':  dest += F("\\\""); break;
+      case '\\': dest += F("\\\\"); break;
+      case '\b': dest += F("\\b"); break;
+      case '\f': dest += F("\\f"); break;
+      case '\n': dest += F("\\n"); break;
+      case '\r': dest += F("\\r"); break;
+      case '\t': dest += F("\\t"); break;
+      default:
+        if ((uint8_t)*c < 0x20) {
+          char esc[7];
+          sprintf_P(esc, PSTR("\\u%04x"), (unsigned)(uint8_t)*c);
+          dest += esc;
+        } else dest += *c;
+    }
+  }
+  dest += '"';
+}
+
+// advances to next non-empty section, returns false when response is complete
+static bool nextJsonStreamSection(JsonStream &js) {
+  while (js.section < JSON_STREAM_END) {
+    js.srcPos = 0;
+    js.progmem = true;
+    switch (js.section++) {
+      case JSON_STREAM_OPEN:     js.src = PSTR("{");                  break;
+      case JSON_STREAM_SI:       js.src = js.si->c_str() + 1; js.srcLen = js.si->length() - 2; js.progmem = false; return true; // without enclosing braces
+      case JSON_STREAM_FX_OPEN:  js.src = PSTR(",\"effects\":[");     break;
+      case JSON_STREAM_FX:
+        // effect names are added in small batches so only a few hundred bytes are held at a time
+        js.fxChunk = "";
+        while (js.fx < strip.getModeCount() && js.fxChunk.length() < 512) {
+          char lineBuffer[256];
+          strncpy_P(lineBuffer, strip.getModeData(js.fx++), sizeof(lineBuffer)-1);
+          lineBuffer[sizeof(lineBuffer)-1] = '\0';
+          if (lineBuffer[0] == 0) continue;
+          char* dataPtr = strchr(lineBuffer,'@');
+          if (dataPtr) *dataPtr = 0; // terminate mode data after name
+          if (!js.fxFirst) js.fxChunk += ',';
+          js.fxFirst = false;
+          appendJsonString(js.fxChunk, lineBuffer);
+        }
+        if (js.fx < strip.getModeCount()) js.section--; // more to come
+        js.src = js.fxChunk.c_str(); js.srcLen = js.fxChunk.length(); js.progmem = false;
+        if (js.srcLen) return true;
+        continue;
+      case JSON_STREAM_PAL_OPEN: js.src = PSTR("],\"palettes\":");    break;
+      case JSON_STREAM_PAL:      js.src = JSON_palette_names;         break;
+      case JSON_STREAM_CLOSE:    js.src = PSTR("}");                  break;
+    }
+    js.srcLen = strlen_P(js.src);
+    return true;
+  }
+  return false;
+}
+
+static bool serveJsonStream(AsyncWebServerRequest* request) {
+  std::shared_ptr<String> si;
+  uint32_t tag;
+  if (!getJsonCache(JSON_CACHE_STATE_INFO, si, tag)) return false;
+  auto js = std::make_shared<JsonStream>();
+  js->si      = si;
+  js->section = JSON_STREAM_OPEN;
+  js->fx      = 0;
+  js->fxFirst = true;
+  js->srcLen  = js->srcPos = 0;
+  js->startHeap = js->minHeap = getFreeHeapSize();
+  DEBUG_PRINTF_P(PSTR("JSON stream start, heap %u\n"), js->minHeap);
+  AsyncWebServerResponse *response = request->beginChunkedResponse(FPSTR(CONTENT_TYPE_JSON),
+    [js](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      size_t len = 0;
+      while (len < maxLen) {
+        if (js->srcPos >= js->srcLen && !nextJsonStreamSection(*js)) {
+          DEBUG_PRINTF_P(PSTR("JSON stream end (%u bytes), min heap %u\n"), index + len, js->minHeap);
+          if (js->startHeap > js->minHeap && js->startHeap - js->minHeap > jsonStreamHeapPeak) jsonStreamHeapPeak = js->startHeap - js->minHeap;
+          break;
+        }
+        size_t n = std::min(maxLen - len, js->srcLen - js->srcPos);
+        if (js->progmem) memcpy_P(buffer + len, js->src + js->srcPos, n);
+        else             memcpy(buffer + len, js->src + js->srcPos, n);
+        len        += n;
+        js->srcPos += n;
+      }
+      js->minHeap = std::min(js->minHeap, (size_t)getFreeHeapSize());
+      return len;
+    });
+  request->send(response);
+  return true;
+}
+
 void serveJson(AsyncWebServerRequest* request)
 {
   enum class json_target {
@@ -1123,13 +1608,42 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
-  if (!requestJSONBufferLock(17)) {
+  if (subJson == json_target::fxdata   && serveStaticJson(request, STATIC_JSON_ID_FXDATA))  return;
+  if (subJson == json_target::effects  && serveStaticJson(request, STATIC_JSON_ID_EFFECTS)) return;
+  if (subJson == json_target::palettes) {
+    int page = request->hasParam(F("page")) ? request->getParam(F("page"))->value().toInt() : 0;
+    page = constrain(page, 0, getPalettesMaxPage());
+    if (serveStaticJson(request, STATIC_JSON_ID_PALETTES + page)) return;
+  }
+
+  if (subJson == json_target::state || subJson == json_target::info || subJson == json_target::state_info) {
+    unsigned idx = subJson == json_target::state ? JSON_CACHE_STATE : subJson == json_target::info ? JSON_CACHE_INFO : JSON_CACHE_STATE_INFO;
+    if (!serveCachedJson(request, idx)) request->deferResponse();
+    return;
+  }
+  if (subJson == json_target::all) {
+    if (!serveJsonStream(request)) request->deferResponse();
+    return;
+  }
+
+  // configuration is the same JSON that was last written to cfg.json: stream the file instead of building a document
+  // (unless changes are still waiting to be written, see serializeConfigToFS())
+  if (subJson == json_target::config && !configNeedsWrite && WLED_FS.exists(F("/cfg.json"))) {
+    AsyncWebServerResponse *response = request->beginResponse(WLED_FS, F("/cfg.json"), FPSTR(CONTENT_TYPE_JSON));
+    response->addHeader(F("Cache-Control"), F("no-store"));
+    request->send(response);
+    return;
+  }
+
+  // GET only serializes, so it can use a pool document and not wait for presets/API calls holding the global buffer
+  JsonDocument *doc = requestJSONDocument(17);
+  if (!doc) {
     request->deferResponse();    
     return;
   }
-  // releaseJSONBufferLock() will be called when "response" is destroyed (from AsyncWebServer)
+  // releaseJSONDocument() will be called when "response" is destroyed (from AsyncWebServer)
   // make sure you delete "response" if no "request->send(response);" is made
-  LockedJsonResponse *response = new LockedJsonResponse(pDoc, subJson==json_target::fxdata || subJson==json_target::effects); // will clear and convert JsonDocument into JsonArray if necessary
+  LockedJsonResponse *response = new LockedJsonResponse(doc, subJson==json_target::fxdata || subJson==json_target::effects); // will clear and convert JsonDocument into JsonArray if necessary
 
   JsonVariant lDoc = response->getRoot();
 
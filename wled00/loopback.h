@@ -0,0 +1,33 @@
+#pragma once
+#ifndef WLED_LOOPBACK_H
+#define WLED_LOOPBACK_H
+/*
+ * Frame capture and wire time emulation of the loopback bus (see BusLoopback)
+ * kept free of Arduino dependencies so it can be verified and benchmarked on the host (tools/loopback_test.cpp)
+ * buffer layout: frame 0 is the live (editing) frame, frames 1..maxFrames are a ring of shown frames
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// emulated transmission time in us of a single wire digital LED strip: 1.25us per bit (2.5us for 400kHz) + 300us latch/reset
+static inline uint32_t loopbackWireTime(size_t len, unsigned channels, bool is16bit, bool halfSpeed) {
+  const uint32_t bits = channels * 8 * (is16bit + 1);
+  return (uint32_t)((len * bits * (halfSpeed ? 2500 : 1250)) / 1000) + 300;
+}
+
+// copies live frame into ring slot of shown frame number frameCount with brightness applied (what would be sent on the wire)
+static inline void loopbackCapture(uint8_t *data, size_t frameSize, unsigned maxFrames, uint32_t frameCount, uint8_t bri) {
+  if (!maxFrames) return;
+  uint8_t *frame = data + frameSize * (1 + frameCount % maxFrames);
+  if (bri == 255) memcpy(frame, data, frameSize);
+  else for (size_t i = 0; i < frameSize; i++) frame[i] = (data[i] * (bri + 1)) >> 8;
+}
+
+// n-th most recent captured frame (0 = last shown) or nullptr if not (or no longer) captured
+static inline const uint8_t *loopbackFrame(const uint8_t *data, size_t frameSize, unsigned maxFrames, uint32_t frameCount, unsigned n) {
+  if (n >= maxFrames || n >= frameCount) return nullptr;
+  return data + frameSize * (1 + (frameCount - 1 - n) % maxFrames);
+}
+
+#endif
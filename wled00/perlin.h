@@ -0,0 +1,277 @@
+#pragma once
+#ifndef WLED_PERLIN_H
+#define WLED_PERLIN_H
+/*
+ * Fixed point integer based Perlin noise functions by @dedehai
+ * Note: optimized for speed and to mimic fastled inoise functions, not for accuracy or best randomness
+ * kept free of Arduino dependencies so the batch (row) functions can be compared with the single sample ones on the host
+ * (tools/perlin_row_test.cpp), perlin16()/perlin8() and the row functions in util.cpp scale the raw values
+ */
+#include <stdint.h>
+#include <string.h>
+
+#define PERLIN_SHIFT 1
+
+// calculate gradient for corner from hash value
+static inline __attribute__((always_inline)) int32_t hashToGradient(uint32_t h) {
+  // using more steps yields more "detailed" perlin noise but looks less like the original fastled version (adjust PERLIN_SHIFT to compensate, also changes range and needs proper adustment)
+  // return (h & 0xFF) - 128; // use PERLIN_SHIFT 7
+  // return (h & 0x0F) - 8; // use PERLIN_SHIFT 3
+  // return (h & 0x07) - 4; // use PERLIN_SHIFT 2
+  return (h & 0x03) - 2; // use PERLIN_SHIFT 1 -> closest to original fastled version
+}
+
+// Gradient functions for 1D, 2D and 3D Perlin noise  note: forcing inline produces smaller code and makes it 3x faster!
+static inline __attribute__((always_inline)) int32_t gradient1D(uint32_t x0, int32_t dx) {
+  uint32_t h = x0 * 0x27D4EB2D;
+  h ^= h >> 15;
+  h *= 0x92C3412B;
+  h ^= h >> 13;
+  h ^= h >> 7;
+  return (hashToGradient(h) * dx) >> PERLIN_SHIFT;
+}
+
+static inline __attribute__((always_inline)) int32_t gradient2D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy) {
+  uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D);
+  h ^= h >> 15;
+  h *= 0x92C3412B;
+  h ^= h >> 13;
+  return (hashToGradient(h) * dx + hashToGradient(h>>PERLIN_SHIFT) * dy) >> (1 + PERLIN_SHIFT);
+}
+
+static inline __attribute__((always_inline)) int32_t gradient3D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy, uint32_t z0, int32_t dz) {
+  // fast and good entropy hash from corner coordinates
+  uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D) ^ (z0 * 0x1B56C4E9);
+  h ^= h >> 15;
+  h *= 0x92C3412B;
+  h ^= h >> 13;
+  return ((hashToGradient(h) * dx + hashToGradient(h>>(1+PERLIN_SHIFT)) * dy + hashToGradient(h>>(1 + 2*PERLIN_SHIFT)) * dz) * 85) >> (8 + PERLIN_SHIFT); // scale to 16bit, x*85 >> 8 = x/3
+}
+
+// fast cubic smoothstep: t*(3 - 2t²), optimized for fixed point, scaled to avoid overflows
+static inline uint32_t smoothstep(const uint32_t t) {
+  uint32_t t_squared = (t * t) >> 16;
+  uint32_t factor = (3 << 16) - ((t << 1));
+  return (t_squared * factor) >> 18; // scale to avoid overflows and give best resolution
+}
+
+// simple linear interpolation for fixed-point values, scaled for perlin noise use
+static inline int32_t lerpPerlin(int32_t a, int32_t b, int32_t t) {
+    return a + (((b - a) * t) >> 14); // match scaling with smoothstep to yield 16.16bit values
+}
+
+// 1D Perlin noise function that returns a value in range of -24691 to 24689
+static inline int32_t perlin1DNoise(uint32_t x, bool is16bit) {
+  // integer and fractional part coordinates
+  int32_t x0 = x >> 16;
+  int32_t x1 = x0 + 1;
+  if(is16bit) x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+
+  int32_t dx0 = x & 0xFFFF;
+  int32_t dx1 = dx0 - 0x10000;
+  // gradient values for the two corners
+  int32_t g0 = gradient1D(x0, dx0);
+  int32_t g1 = gradient1D(x1, dx1);
+  // interpolate and smooth function
+  int32_t tx = smoothstep(dx0);
+  int32_t noise = lerpPerlin(g0, g1, tx);
+  return noise;
+}
+
+// 2D Perlin noise function that returns a value in range of -20633 to 20629
+static inline int32_t perlin2DNoise(uint32_t x, uint32_t y, bool is16bit) {
+  int32_t x0 = x >> 16;
+  int32_t y0 = y >> 16;
+  int32_t x1 = x0 + 1;
+  int32_t y1 = y0 + 1;
+
+  if(is16bit) {
+    x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+    y1 = y1 & 0xFF;
+  }
+
+  int32_t dx0 = x & 0xFFFF;
+  int32_t dy0 = y & 0xFFFF;
+  int32_t dx1 = dx0 - 0x10000;
+  int32_t dy1 = dy0 - 0x10000;
+
+  int32_t g00 = gradient2D(x0, dx0, y0, dy0);
+  int32_t g10 = gradient2D(x1, dx1, y0, dy0);
+  int32_t g01 = gradient2D(x0, dx0, y1, dy1);
+  int32_t g11 = gradient2D(x1, dx1, y1, dy1);
+
+  uint32_t tx = smoothstep(dx0);
+  uint32_t ty = smoothstep(dy0);
+
+  int32_t nx0 = lerpPerlin(g00, g10, tx);
+  int32_t nx1 = lerpPerlin(g01, g11, tx);
+
+  int32_t noise = lerpPerlin(nx0, nx1, ty);
+  return noise;
+}
+
+// 3D Perlin noise function that returns a value in range of -16788 to 16381
+static inline int32_t perlin3DNoise(uint32_t x, uint32_t y, uint32_t z, bool is16bit) {
+  int32_t x0 = x >> 16;
+  int32_t y0 = y >> 16;
+  int32_t z0 = z >> 16;
+  int32_t x1 = x0 + 1;
+  int32_t y1 = y0 + 1;
+  int32_t z1 = z0 + 1;
+
+  if(is16bit) {
+    x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+    y1 = y1 & 0xFF;
+    z1 = z1 & 0xFF;
+  }
+
+  int32_t dx0 = x & 0xFFFF;
+  int32_t dy0 = y & 0xFFFF;
+  int32_t dz0 = z & 0xFFFF;
+  int32_t dx1 = dx0 - 0x10000;
+  int32_t dy1 = dy0 - 0x10000;
+  int32_t dz1 = dz0 - 0x10000;
+
+  int32_t g000 = gradient3D(x0, dx0, y0, dy0, z0, dz0);
+  int32_t g001 = gradient3D(x0, dx0, y0, dy0, z1, dz1);
+  int32_t g010 = gradient3D(x0, dx0, y1, dy1, z0, dz0);
+  int32_t g011 = gradient3D(x0, dx0, y1, dy1, z1, dz1);
+  int32_t g100 = gradient3D(x1, dx1, y0, dy0, z0, dz0);
+  int32_t g101 = gradient3D(x1, dx1, y0, dy0, z1, dz1);
+  int32_t g110 = gradient3D(x1, dx1, y1, dy1, z0, dz0);
+  int32_t g111 = gradient3D(x1, dx1, y1, dy1, z1, dz1);
+
+  uint32_t tx = smoothstep(dx0);
+  uint32_t ty = smoothstep(dy0);
+  uint32_t tz = smoothstep(dz0);
+
+  int32_t nx0 = lerpPerlin(g000, g100, tx);
+  int32_t nx1 = lerpPerlin(g010, g110, tx);
+  int32_t nx2 = lerpPerlin(g001, g101, tx);
+  int32_t nx3 = lerpPerlin(g011, g111, tx);
+  int32_t ny0 = lerpPerlin(nx0, nx1, ty);
+  int32_t ny1 = lerpPerlin(nx2, nx3, ty);
+
+  int32_t noise = lerpPerlin(ny0, ny1, tz);
+  return noise;
+}
+
+/*
+ * Batch Perlin noise: fills a row of samples along x (y and z are fixed), results are identical to the single sample functions
+ * hashes of the lattice corners are shared by all samples in a lattice cell (and the x1 corners are reused as x0 corners of the
+ * next cell), the y/z parts of the gradient dot products and the y/z smoothstep are calculated once per row
+ */
+// mix hash of a corner, same as in gradient2D() and gradient3D()
+static inline __attribute__((always_inline)) uint32_t perlinMix(uint32_t h) {
+  h ^= h >> 15;
+  h *= 0x92C3412B;
+  h ^= h >> 13;
+  return h;
+}
+
+template<typename XCoord, typename Store>
+static inline __attribute__((always_inline)) void perlin2DRow_raw(unsigned count, XCoord nextX, uint32_t y, bool is16bit, Store store) {
+  int32_t y0 = y >> 16;
+  int32_t y1 = y0 + 1;
+  if (is16bit) y1 = y1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+  const int32_t dy[2] = { int32_t(y & 0xFFFF), int32_t(y & 0xFFFF) - 0x10000 };
+  const uint32_t hy[2] = { uint32_t(y0) * 0xB5297A4D, uint32_t(y1) * 0xB5297A4D };
+  const uint32_t ty = smoothstep(dy[0]);
+
+  int32_t gx[2][2], gy[2][2]; // [x corner][y corner]: x gradient and y part of dot product
+  const auto corners = [&](unsigned c, uint32_t xc) {
+    for (unsigned j = 0; j < 2; j++) {
+      uint32_t h = perlinMix((xc * 0x27D4EB2D) ^ hy[j]);
+      gx[c][j] = hashToGradient(h);
+      gy[c][j] = hashToGradient(h >> PERLIN_SHIFT) * dy[j];
+    }
+  };
+  int32_t cellX0 = 0, cellX1 = -1; // lattice coordinates of cached corners (none cached yet)
+  for (unsigned i = 0; i < count; i++) {
+    uint32_t x = nextX();
+    int32_t x0 = x >> 16;
+    if (x0 != cellX0 || cellX1 < 0) {
+      int32_t x1 = x0 + 1;
+      if (is16bit) x1 = x1 & 0xFF;
+      if (x0 == cellX1) { // moved to next cell: old x1 corners become x0 corners
+        memcpy(gx[0], gx[1], sizeof(gx[0]));
+        memcpy(gy[0], gy[1], sizeof(gy[0]));
+      } else corners(0, x0);
+      corners(1, x1);
+      cellX0 = x0;
+      cellX1 = x1;
+    }
+    int32_t dx0 = x & 0xFFFF;
+    int32_t dx1 = dx0 - 0x10000;
+    int32_t g00 = (gx[0][0] * dx0 + gy[0][0]) >> (1 + PERLIN_SHIFT);
+    int32_t g10 = (gx[1][0] * dx1 + gy[1][0]) >> (1 + PERLIN_SHIFT);
+    int32_t g01 = (gx[0][1] * dx0 + gy[0][1]) >> (1 + PERLIN_SHIFT);
+    int32_t g11 = (gx[1][1] * dx1 + gy[1][1]) >> (1 + PERLIN_SHIFT);
+    uint32_t tx = smoothstep(dx0);
+    int32_t nx0 = lerpPerlin(g00, g10, tx);
+    int32_t nx1 = lerpPerlin(g01, g11, tx);
+    store(i, lerpPerlin(nx0, nx1, ty));
+  }
+}
+
+template<typename XCoord, typename Store>
+static inline __attribute__((always_inline)) void perlin3DRow_raw(unsigned count, XCoord nextX, uint32_t y, uint32_t z, bool is16bit, Store store) {
+  int32_t y0 = y >> 16;
+  int32_t z0 = z >> 16;
+  int32_t y1 = y0 + 1;
+  int32_t z1 = z0 + 1;
+  if (is16bit) {
+    y1 = y1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+    z1 = z1 & 0xFF;
+  }
+  const int32_t dy0 = y & 0xFFFF, dz0 = z & 0xFFFF;
+  // y/z corners in order (y0,z0), (y1,z0), (y0,z1), (y1,z1)
+  const int32_t dy[4] = { dy0, dy0 - 0x10000, dy0, dy0 - 0x10000 };
+  const int32_t dz[4] = { dz0, dz0, dz0 - 0x10000, dz0 - 0x10000 };
+  const uint32_t hyz[4] = { (uint32_t(y0) * 0xB5297A4D) ^ (uint32_t(z0) * 0x1B56C4E9), (uint32_t(y1) * 0xB5297A4D) ^ (uint32_t(z0) * 0x1B56C4E9),
+                            (uint32_t(y0) * 0xB5297A4D) ^ (uint32_t(z1) * 0x1B56C4E9), (uint32_t(y1) * 0xB5297A4D) ^ (uint32_t(z1) * 0x1B56C4E9) };
+  const uint32_t ty = smoothstep(dy0);
+  const uint32_t tz = smoothstep(dz0);
+
+  int32_t gx[2][4], gyz[2][4]; // [x corner][y/z corner]: x gradient and y/z part of dot product
+  const auto corners = [&](unsigned c, uint32_t xc) {
+    for (unsigned j = 0; j < 4; j++) {
+      uint32_t h = perlinMix((xc * 0x27D4EB2D) ^ hyz[j]);
+      gx[c][j]  = hashToGradient(h);
+      gyz[c][j] = hashToGradient(h >> (1 + PERLIN_SHIFT)) * dy[j] + hashToGradient(h >> (1 + 2*PERLIN_SHIFT)) * dz[j];
+    }
+  };
+  int32_t cellX0 = 0, cellX1 = -1; // lattice coordinates of cached corners (none cached yet)
+  for (unsigned i = 0; i < count; i++) {
+    uint32_t x = nextX();
+    int32_t x0 = x >> 16;
+    if (x0 != cellX0 || cellX1 < 0) {
+      int32_t x1 = x0 + 1;
+      if (is16bit) x1 = x1 & 0xFF;
+      if (x0 == cellX1) { // moved to next cell: old x1 corners become x0 corners
+        memcpy(gx[0], gx[1], sizeof(gx[0]));
+        memcpy(gyz[0], gyz[1], sizeof(gyz[0]));
+      } else corners(0, x0);
+      corners(1, x1);
+      cellX0 = x0;
+      cellX1 = x1;
+    }
+    int32_t dx0 = x & 0xFFFF;
+    int32_t dx1 = dx0 - 0x10000;
+    int32_t g[2][4];
+    for (unsigned j = 0; j < 4; j++) {
+      g[0][j] = ((gx[0][j] * dx0 + gyz[0][j]) * 85) >> (8 + PERLIN_SHIFT); // scale to 16bit, x*85 >> 8 = x/3
+      g[1][j] = ((gx[1][j] * dx1 + gyz[1][j]) * 85) >> (8 + PERLIN_SHIFT);
+    }
+    uint32_t tx = smoothstep(dx0);
+    int32_t nx0 = lerpPerlin(g[0][0], g[1][0], tx);
+    int32_t nx1 = lerpPerlin(g[0][1], g[1][1], tx);
+    int32_t nx2 = lerpPerlin(g[0][2], g[1][2], tx);
+    int32_t nx3 = lerpPerlin(g[0][3], g[1][3], tx);
+    int32_t ny0 = lerpPerlin(nx0, nx1, ty);
+    int32_t ny1 = lerpPerlin(nx2, nx3, ty);
+    store(i, lerpPerlin(ny0, ny1, tz));
+  }
+}
+
+#endif
@@ -0,0 +1,111 @@
+#pragma once
+#ifndef WLED_PIXEL_BLUR_H
+#define WLED_PIXEL_BLUR_H
+/*
+ * Two-channels-per-word color helpers and blur kernels working on raw pixel buffers (0xWWRRGGBB)
+ * used by Segment::blur(), blur2D() and box_blur(), kept free of Arduino dependencies so they can be
+ * compared with the previous kernels and benchmarked on the host (tools/pixel_blur_test.cpp)
+ */
+#include <stdint.h>
+
+// fast scaling function for colors, performs color*scale/256 for all four channels, speed over accuracy
+// note: inlining uses less code than actual function calls
+static inline uint32_t fast_color_scale(const uint32_t c, const uint8_t scale) {
+  uint32_t rb = (((c     & 0x00FF00FF) * scale) >> 8) &  0x00FF00FF;
+  uint32_t wg = (((c>>8) & 0x00FF00FF) * scale)       & ~0x00FF00FF;
+  return rb | wg;
+}
+
+// fast saturating add of up to three colors (no color ratio preservation), channels are summed in 16 bit lanes and saturated once
+static inline uint32_t fast_color_add(const uint32_t c1, const uint32_t c2, const uint32_t c3 = 0) {
+  uint32_t rb = ( c1     & 0x00FF00FF) + ( c2     & 0x00FF00FF) + ( c3     & 0x00FF00FF); // max. 0x2FD per lane
+  uint32_t wg = ((c1>>8) & 0x00FF00FF) + ((c2>>8) & 0x00FF00FF) + ((c3>>8) & 0x00FF00FF);
+  uint32_t ovrb = (rb >> 8) & 0x00030003; // bits above 8 bits
+  uint32_t ovwg = (wg >> 8) & 0x00030003;
+  rb |= ((ovrb | (ovrb >> 1)) & 0x00010001) * 0xFF; // saturate lanes that overflowed
+  wg |= ((ovwg | (ovwg >> 1)) & 0x00010001) * 0xFF;
+  return (rb & 0x00FF00FF) | ((wg & 0x00FF00FF) << 8);
+}
+
+/*
+ * in-place blur of consecutive pixels, source: FastLED colorutils.cpp
+ * each pixel keeps "keep" of itself and receives "seep" of both neighbours, neighbour values are carried in registers
+ * so every pixel is read and written once and saturated only once (same result as adding the parts one by one)
+ */
+static inline void blurPixelLine(uint32_t *line, unsigned length, uint8_t keep, uint8_t seep) {
+  if (length < 2) { if (length) line[0] = fast_color_scale(line[0], keep); return; }
+  uint32_t carryover = 0;                          // part of pixel i-2 seeping into pixel i-1
+  uint32_t prevKeep  = fast_color_scale(line[0], keep);
+  uint32_t prevPart  = fast_color_scale(line[0], seep);
+  for (unsigned i = 1; i < length; i++) {
+    const uint32_t cur  = line[i];
+    const uint32_t part = fast_color_scale(cur, seep);
+    line[i - 1] = fast_color_add(prevKeep, carryover, part); // previous pixel is complete
+    carryover = prevPart;
+    prevPart  = part;
+    prevKeep  = fast_color_scale(cur, keep);
+  }
+  line[length - 1] = fast_color_add(prevKeep, carryover); // last pixel
+}
+
+// same blur on all columns of a cols x rows buffer, walking it row by row (cache friendly, pixel buffer may be in PSRAM)
+// carryover needs cols entries (part of the row above seeping into the current row)
+static inline void blurPixelColumns(uint32_t *pxls, unsigned cols, unsigned rows, uint8_t keep, uint8_t seep, uint32_t *carryover) {
+  if (rows < 2) {
+    for (unsigned x = 0; x < cols; x++) pxls[x] = fast_color_scale(pxls[x], keep);
+    return;
+  }
+  // handle first row
+  for (unsigned x = 0; x < cols; x++) {
+    carryover[x] = fast_color_scale(pxls[x], seep);
+    pxls[x] = fast_color_scale(pxls[x], keep);
+  }
+  for (unsigned y = 1; y < rows; y++) {
+    uint32_t *prev = pxls + (y - 1) * cols;
+    uint32_t *cur  = pxls + y * cols;
+    for (unsigned x = 0; x < cols; x++) {
+      const uint32_t c    = cur[x];
+      const uint32_t part = fast_color_scale(c, seep);
+      prev[x] = fast_color_add(prev[x], part); // previous row
+      cur[x]  = fast_color_add(fast_color_scale(c, keep), carryover[x]); // current row
+      carryover[x] = part;
+    }
+  }
+}
+
+// box blur of "length" pixels spaced by "stride" (window of 2*radius+1 pixels, radius <= 3) using a running window sum
+// line needs length entries (unmodified copy of the pixels), if smear is set pixels do not get darker
+static inline void boxBlurPixelLine(uint32_t *dst, unsigned length, unsigned stride, unsigned radius, bool smear, uint32_t *line) {
+  for (unsigned i = 0; i < length; i++) line[i] = dst[i * stride];
+  uint32_t rbSum = 0, wgSum = 0; // sums of two channels each in 16 bit lanes (max. 7*255)
+  unsigned n = 0;                // number of pixels in window (less at the edges)
+  for (unsigned i = 0; i < radius && i < length; i++, n++) {
+    rbSum +=  line[i]       & 0x00FF00FF;
+    wgSum += (line[i] >> 8) & 0x00FF00FF;
+  }
+  for (unsigned i = 0; i < length; i++) {
+    if (i + radius < length) { // pixel entering window
+      rbSum +=  line[i + radius]       & 0x00FF00FF;
+      wgSum += (line[i + radius] >> 8) & 0x00FF00FF;
+      n++;
+    }
+    if (i > radius) { // pixel leaving window
+      rbSum -=  line[i - radius - 1]       & 0x00FF00FF;
+      wgSum -= (line[i - radius - 1] >> 8) & 0x00FF00FF;
+      n--;
+    }
+    const unsigned inv = (65535U + n) / n; // division by multiplication (rounded up so full sums are exact)
+    uint32_t c = ((((wgSum >> 16) * inv) >> 16) << 24) | ((((rbSum >> 16) * inv) >> 16) << 16) | ((((wgSum & 0xFFFF) * inv) >> 16) << 8) | (((rbSum & 0xFFFF) * inv) >> 16);
+    if (smear) { // per channel maximum of average and original
+      uint32_t m = 0;
+      for (unsigned shift = 0; shift < 32; shift += 8) {
+        const uint32_t a = (c >> shift) & 0xFF, o = (line[i] >> shift) & 0xFF;
+        m |= (a > o ? a : o) << shift;
+      }
+      c = m;
+    }
+    dst[i * stride] = c;
+  }
+}
+
+#endif
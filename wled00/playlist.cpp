@@ -24,6 +24,13 @@ static int16_t        parentPlaylistIndex = -1;
 static byte           parentPlaylistRepeat = 0;
 static byte           parentPlaylistPresetId = 0; //for re-loading
 
+static bool           playlistPrefetched = false; //next entry has been prefetched (or there is nothing to prefetch)
+static bool           playlistShuffled = false;   //playlist was shuffled ahead of roll-over to know the next entry
+
+#ifndef PLAYLIST_PREFETCH_DELAY
+#define PLAYLIST_PREFETCH_DELAY 500 // ms after preset change before next preset is prefetched (let transition start first)
+#endif
+
 
 void shufflePlaylist() {
   int currentIndex = playlistLen;
@@ -48,7 +55,9 @@ void unloadPlaylist() {
     playlistEntries = nullptr;
   }
   currentPlaylist = playlistIndex = -1;
+  stateVersion++;
   playlistLen = playlistEntryDur = playlistOptions = 0;
+  playlistPrefetched = playlistShuffled = false;
   DEBUG_PRINTLN(F("Playlist unloaded."));
 }
 
@@ -142,10 +151,28 @@ int16_t loadPlaylist(JsonObject playlistObj, byte presetId) {
 }
 
 
+// returns preset that will be applied after current entry (0 if unknown)
+static byte getNextPlaylistPreset() {
+  int next = playlistIndex + 1;
+  if (next < playlistLen) return playlistEntries[next].preset;
+  // roll-over
+  if (playlistRepeat == 1) return parentPlaylistPresetId > 0 ? 0 : playlistEndPreset;
+  if ((playlistOptions & PL_OPTION_SHUFFLE) && !playlistShuffled && playlistIndex >= 0) {
+    shufflePlaylist(); // shuffle ahead of time (current entry has already been applied)
+    playlistShuffled = true;
+  }
+  return playlistEntries[0].preset;
+}
+
 void handlePlaylist() {
   static unsigned long presetCycledTime = 0;
   if (currentPlaylist < 0 || playlistEntries == nullptr) return;
 
+  // read next preset during idle time so that the switch does not need file system access
+  if (!playlistPrefetched && !doAdvancePlaylist && millis() - presetCycledTime > PLAYLIST_PREFETCH_DELAY && playlistEntryDur > PLAYLIST_PREFETCH_DELAY/100) {
+    playlistPrefetched = prefetchPreset(getNextPlaylistPreset());
+  }
+
   if ((playlistEntryDur < UINT16_MAX && millis() - presetCycledTime > 100 * playlistEntryDur) || doAdvancePlaylist) {
     presetCycledTime = millis();
     if (bri == 0 || nightlightActive) return;
@@ -164,7 +191,8 @@ void handlePlaylist() {
       }
       if (playlistRepeat > 1) playlistRepeat--; // decrease repeat count on each index reset if not an endless playlist
       // playlistRepeat == 0: endless loop
-      if (playlistOptions & PL_OPTION_SHUFFLE) shufflePlaylist(); // shuffle playlist and start over
+      if ((playlistOptions & PL_OPTION_SHUFFLE) && !playlistShuffled) shufflePlaylist(); // shuffle playlist and start over
+      playlistShuffled = false;
     }
 
     jsonTransitionOnce = true;
@@ -172,6 +200,7 @@ void handlePlaylist() {
     playlistEntryDur = playlistEntries[playlistIndex].dur > 0 ? playlistEntries[playlistIndex].dur : UINT16_MAX;
     applyPresetFromPlaylist(playlistEntries[playlistIndex].preset);
     doAdvancePlaylist = false;
+    playlistPrefetched = false;
   }
 }
 
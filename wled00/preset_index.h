@@ -0,0 +1,50 @@
+#pragma once
+#ifndef WLED_PRESET_INDEX_H
+#define WLED_PRESET_INDEX_H
+/*
+ * Single pass scanner building the preset id -> file offset index and free space holes of presets.json (see file.cpp)
+ * kept free of Arduino dependencies so it can be verified on the host (tools/preset_index_test.cpp)
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+#define PRESET_INDEX_SIZE 256
+
+// scanner state carried between buffers of the file
+typedef struct {
+  size_t   pos = 0;       // file offset of next byte
+  size_t   run = 0;       // consecutive spaces between root level objects
+  int      depth = 0;
+  int      id = -1;       // numeric root level key being parsed
+  unsigned keyState = 0;  // 1: key closed, expecting ':'  2: expecting '{'
+  bool     inStr = false;
+  bool     esc = false;
+} PresetIndexScan;
+
+// feeds next len bytes of the file: index[id] is set to the offset of the '{' of root level object "id",
+// hole(pos, len) is called for each run of spaces between root level objects
+template<class H>
+static inline void presetIndexScan(PresetIndexScan &s, const uint8_t *buf, size_t len, uint32_t *index, H hole) {
+  for (size_t i = 0; i < len; i++, s.pos++) {
+    char c = buf[i];
+    if (s.inStr) {
+      if (s.esc) s.esc = false;
+      else if (c == '\\') s.esc = true;
+      else if (c == '"') { s.inStr = false; if (s.id >= 0) s.keyState = 1; }
+      else if (s.id >= 0) s.id = (c >= '0' && c <= '9' && s.id < PRESET_INDEX_SIZE) ? s.id*10 + (c-'0') : -1;
+      continue;
+    }
+    if (s.depth == 1 && c == ' ') { s.run++; continue; }
+    if (s.run) {
+      hole(s.pos - s.run, s.run);
+      s.run = 0;
+    }
+    if (s.keyState == 2 && c == '{' && s.id < PRESET_INDEX_SIZE) index[s.id] = s.pos;
+    s.keyState = (s.keyState == 1 && c == ':') ? 2 : 0; // key must be immediately followed by ':' and '{' (see structural requirements)
+    if      (c == '{') s.depth++;
+    else if (c == '}') s.depth--;
+    else if (c == '"') { s.inStr = true; s.id = (s.depth == 1) ? 0 : -1; }
+  }
+}
+
+#endif
@@ -26,12 +26,116 @@ bool presetNeedsSaving() {
   return presetToSave;
 }
 
+// accessing FS during sendout causes glitches: instead of spinning until strip is idle return true so that
+// caller can retry on next loop() iteration (but do not wait for longer than one frame)
+static bool deferWhileStripUpdating() {
+  static unsigned long deferredSince = 0;
+  if (!strip.isUpdating()) {
+    deferredSince = 0;
+    return false;
+  }
+  if (deferredSince == 0) deferredSince = millis();
+  if (millis() - deferredSince < strip.getFrameTime()) return true;
+  deferredSince = 0; // waited long enough
+  return false;
+}
+
+/*
+ * Preset cache
+ * A read cache: the JSON of recently applied, saved or prefetched presets is kept in RAM (minified) so that
+ * applying them needs no file system access. Cached presets are still parsed and applied through
+ * deserializeState() like presets read from the file system (copying a pre-parsed JsonDocument instead saves
+ * little over parsing but needs 4-5 times the RAM, see tools/preset_cache_test.cpp).
+ * The cache is flushed whenever presets.json is written (see presetsModifiedCount).
+ */
+#ifndef WLED_PRESET_CACHE_SIZE // number of cached presets (at least 1)
+  #ifdef ESP8266
+    #define WLED_PRESET_CACHE_SIZE 1
+  #else
+    #define WLED_PRESET_CACHE_SIZE 8
+  #endif
+#endif
+#ifndef WLED_PRESET_CACHE_MAXLEN // presets with longer JSON are not cached
+  #ifdef ESP8266
+    #define WLED_PRESET_CACHE_MAXLEN 1024
+  #else
+    #define WLED_PRESET_CACHE_MAXLEN 4096
+  #endif
+#endif
+
+typedef struct {
+  unsigned long used; // for LRU replacement
+  uint8_t id;
+  char   *json;       // stored in the same allocation after this header
+} CachedPreset;
+
+static CachedPreset *cachedPresets[WLED_PRESET_CACHE_SIZE] = {nullptr};
+static uint16_t cachedPresetsModified = 0;
+static byte cachedPresetsValidate = 0;
+// staging buffer for prefetched presets that do not fit into the cache (see prefetchPreset())
+static char *stagedPresetJson = nullptr;
+static byte  stagedPreset = 0;
+
+static void dropCachedPreset(unsigned i) {
+  p_free(cachedPresets[i]);
+  cachedPresets[i] = nullptr;
+}
+
+static void dropStagedPreset() {
+  p_free(stagedPresetJson);
+  stagedPresetJson = nullptr;
+  stagedPreset = 0;
+}
+
+// flush cache if presets.json was written since the presets were cached
+static void validatePresetCache() {
+  if (cachedPresetsModified == presetsModifiedCount && cachedPresetsValidate == cacheInvalidate) return;
+  for (unsigned i = 0; i < WLED_PRESET_CACHE_SIZE; i++) dropCachedPreset(i);
+  dropStagedPreset();
+  cachedPresetsModified = presetsModifiedCount;
+  cachedPresetsValidate = cacheInvalidate;
+}
+
+// returns cached JSON of preset or nullptr (const so that deserializeJson() copies strings)
+static const char *getCachedPreset(byte index) {
+  if (index == 0 || index > 250) return nullptr;
+  validatePresetCache();
+  for (unsigned i = 0; i < WLED_PRESET_CACHE_SIZE; i++) {
+    if (!cachedPresets[i] || cachedPresets[i]->id != index) continue;
+    cachedPresets[i]->used = millis();
+    return cachedPresets[i]->json;
+  }
+  return nullptr;
+}
+
+// (re)places preset JSON in cache, returns false if it was not cached (too long or out of memory)
+static bool cachePreset(byte index, const JsonDocument &doc) {
+  validatePresetCache();
+  unsigned slot = 0;
+  for (unsigned i = 0; i < WLED_PRESET_CACHE_SIZE; i++) {
+    if (cachedPresets[i] && cachedPresets[i]->id == index) dropCachedPreset(i);
+    if (!cachedPresets[i]) slot = i;
+    else if (cachedPresets[slot] && cachedPresets[i]->used < cachedPresets[slot]->used) slot = i; // least recently used
+  }
+  if (index == 0 || index > 250 || doc.isNull()) return false;
+  size_t len = measureJson(doc) + 1;
+  if (len > WLED_PRESET_CACHE_MAXLEN) return false;
+
+  dropCachedPreset(slot);
+  CachedPreset *cp = (CachedPreset*)p_malloc(sizeof(CachedPreset) + len);
+  if (!cp) return false;
+  cp->json = reinterpret_cast<char*>(cp + 1);
+  serializeJson(doc, cp->json, len);
+  cp->id = index;
+  cp->used = millis();
+  cachedPresets[slot] = cp;
+  DEBUG_PRINTF_P(PSTR("Cached preset %u (%u bytes).\n"), (unsigned)index, (unsigned)len);
+  return true;
+}
+
 static void doSaveState() {
   bool persist = (presetToSave < 251);
 
-  unsigned long maxWait = millis() + strip.getFrameTime();
-  while (strip.isUpdating() && millis() < maxWait) delay(1); // wait for strip to finish updating, accessing FS during sendout causes glitches
-
   if (!requestJSONBufferLock(10)) return;
 
   initPresetsFile(); // just in case if someone deleted presets.json using /edit
@@ -55,6 +159,7 @@ static void doSaveState() {
     DEBUG_PRINTLN();
   #endif
 */
+  bool written = false;
   #if defined(ARDUINO_ARCH_ESP32)
   if (!persist) {
     p_free(tmpRAMbuffer);
@@ -68,9 +173,12 @@ static void doSaveState() {
     }
   } else
   #endif
-  writeObjectToFileUsingId(getPresetsFileName(persist), presetToSave, pDoc);
+  written = writeObjectToFileUsingId(getPresetsFileName(persist), presetToSave, pDoc);
 
-  if (persist) presetsModifiedTime = toki.second(); //unix time
+  if (persist) {
+    presetsModifiedTime = toki.second(); //unix time
+    if (written) cachePreset(presetToSave, *pDoc); // saved presets are likely applied soon (only if file has them too)
+  }
   releaseJSONBufferLock();
   updateFSInfo();
 
@@ -145,37 +253,61 @@ void applyPresetWithFallback(uint8_t index, uint8_t callMode, uint8_t effectID,
 void handlePresets()
 {
   byte presetErrFlag = ERR_NONE;
+  // presets.json may have been replaced by upload or /edit: invalidate preset cache and file index
+  // (counter is only modified under JSON buffer lock, like all writes to presets.json)
+  if (presetsFileChanged && requestJSONBufferLock(25)) {
+    presetsFileChanged = false;
+    presetsModifiedCount++;
+    releaseJSONBufferLock();
+  }
   if (presetToSave) {
+    if (deferWhileStripUpdating()) return;
     strip.suspend();
     doSaveState();
     strip.resume();
     return;
   }
 
-  if (presetToApply == 0 || !requestJSONBufferLock(9)) return; // no preset waiting to apply, or JSON buffer is already allocated, return to loop until free
+  if (presetToApply == 0) { // no preset waiting to apply
+    // rewrite presets.json if deleted/replaced presets left too many holes
+    if (presetsNeedCompaction() && !jsonBufferLock && !deferWhileStripUpdating() && requestJSONBufferLock(23)) {
+      strip.suspend();
+      compactPresetsFile();
+      strip.resume();
+      releaseJSONBufferLock();
+    }
+    return;
+  }
+  const char *cached = getCachedPreset(presetToApply);
+  const bool staged = presetToApply == stagedPreset && stagedPresetJson; // prefetched JSON, no FS access needed
+  if (!staged) dropStagedPreset(); // a different preset is applied, staged one is stale (i.e. playlist was stopped)
+  #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
+  if (!cached && !staged && deferWhileStripUpdating()) return;
+  #endif
+  if (!requestJSONBufferLock(9)) return; // JSON buffer is already allocated, return to loop until free
 
   bool changePreset = false;
   uint8_t tmpPreset = presetToApply; // store temporary since deserializeState() may call applyPreset()
   uint8_t tmpMode   = callModeToApply;
 
-  JsonObject fdo;
-
   presetToApply = 0; //clear request for preset
   callModeToApply = 0;
 
-  DEBUG_PRINTF_P(PSTR("Applying preset: %u\n"), (unsigned)tmpPreset);
+  JsonObject fdo;
 
-  #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
-  unsigned long maxWait = millis() + strip.getFrameTime();
-  while (strip.isUpdating() && millis() < maxWait) delay(1); // wait for strip to finish updating, accessing FS during sendout causes glitches
-  #endif
+  DEBUG_PRINTF_P(PSTR("Applying preset: %u\n"), (unsigned)tmpPreset);
 
   #ifdef ARDUINO_ARCH_ESP32
   if (tmpPreset==255 && tmpRAMbuffer!=nullptr) {
     deserializeJson(*pDoc,tmpRAMbuffer);
   } else
   #endif
-  {
+  if (cached) {
+    presetErrFlag = deserializeJson(*pDoc, cached) ? ERR_FS_PLOAD : ERR_NONE;
+  } else if (staged) {
+    presetErrFlag = deserializeJson(*pDoc, (const char*)stagedPresetJson) ? ERR_FS_PLOAD : ERR_NONE; // const: copy strings as buffer is freed
+    dropStagedPreset();
+  } else {
   presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
   }
   fdo = pDoc->as<JsonObject>();
@@ -183,6 +315,8 @@ void handlePresets()
   // only reset errorflag if previous error was preset-related
   if ((errorFlag == ERR_NONE) || (errorFlag == ERR_FS_PLOAD)) errorFlag = presetErrFlag;
 
+  if (presetErrFlag == ERR_NONE && tmpPreset < 255 && !cached) cachePreset(tmpPreset, *pDoc); // next time apply without FS access (before deserializeState() modifies it)
+
   //HTTP API commands
   const char* httpwin = fdo["win"];
   if (httpwin) {
@@ -214,6 +348,33 @@ void handlePresets()
   updateInterfaces(tmpMode);
 }
 
+// reads preset ahead of time (i.e. next playlist entry, called from loop()) so that applying it later needs
+// no file system access: caches it or, if it does not fit into the cache, keeps its JSON in a staging buffer
+// returns false if it should be retried later
+bool prefetchPreset(byte index)
+{
+  if (index == 0 || index > 250) return true;
+  if (presetToApply || presetToSave) return false; // busy
+  if (getCachedPreset(index) || (index == stagedPreset && stagedPresetJson)) return true; // already prefetched
+  if (strip.isUpdating() || jsonBufferLock) return false; // accessing FS during sendout causes glitches
+  if (!requestJSONBufferLock(24)) return false;
+
+  if (readObjectFromFileUsingId(getPresetsFileName(), index, pDoc)) {
+    if (!cachePreset(index, *pDoc)) {
+      dropStagedPreset();
+      size_t len = measureJson(*pDoc) + 1;
+      stagedPresetJson = (char*)p_malloc(len);
+      if (stagedPresetJson) {
+        serializeJson(*pDoc, stagedPresetJson, len);
+        stagedPreset = index;
+      }
+    }
+    DEBUG_PRINTF_P(PSTR("Prefetched preset %u (%s).\n"), (unsigned)index, stagedPreset == index ? "staged" : "cached");
+  }
+  releaseJSONBufferLock();
+  return true;
+}
+
 //called from handleSet(PS=) [network callback (sObj is empty), IR (irrational), deserializeState, UDP] and deserializeState() [network callback (filedoc!=nullptr)]
 void savePreset(byte index, const char* pname, JsonObject sObj)
 {
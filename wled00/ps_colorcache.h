@@ -0,0 +1,60 @@
+#pragma once
+#ifndef WLED_PS_COLORCACHE_H
+#define WLED_PS_COLORCACHE_H
+/*
+ * Per frame color cache for particle rendering (see FXparticleSystem.cpp)
+ * palette colors are looked up once per index and frame, desaturated colors are kept in a small direct mapped cache as particles of an emitter usually share hue and saturation
+ * kept free of Arduino dependencies so it can be verified and benchmarked on the host (tools/ps_colorcache_test.cpp)
+ */
+#include <stdint.h>
+#include <string.h>
+
+#define PS_SATCACHE_SIZE 32 // must be a power of 2
+
+typedef struct {
+  uint32_t color[256];   // palette colors
+  uint32_t valid[8];     // bitmap of valid palette colors
+  struct {
+    uint32_t color;
+    uint8_t index;
+    uint8_t sat;         // 255 marks an empty entry
+  } satColor[PS_SATCACHE_SIZE];
+} PScolorCache;
+
+// invalidates all entries (palette or blend mode may have changed since last frame)
+static inline void psResetColorCache(PScolorCache *cache) {
+  memset(cache->valid, 0, sizeof(cache->valid));
+  for (unsigned i = 0; i < PS_SATCACHE_SIZE; i++)
+    cache->satColor[i].sat = 255;
+}
+
+// palette color of index, lookup(index) is only called on the first use of index after a reset (or always without cache)
+template<class L>
+static inline uint32_t psCachedPaletteColor(PScolorCache *cache, const uint8_t index, L lookup) {
+  if (cache == nullptr)
+    return lookup(index); // no cache memory
+  uint32_t &bits = cache->valid[index >> 5];
+  const uint32_t mask = 1U << (index & 0x1F);
+  if (!(bits & mask)) {
+    cache->color[index] = lookup(index);
+    bits |= mask;
+  }
+  return cache->color[index];
+}
+
+// palette color of index with saturation limited to sat by desaturate(color, sat)
+template<class L, class D>
+static inline uint32_t psCachedSaturatedColor(PScolorCache *cache, const uint8_t index, const uint8_t sat, L lookup, D desaturate) {
+  const unsigned slot = (index ^ (sat * 7)) & (PS_SATCACHE_SIZE - 1);
+  if (cache && cache->satColor[slot].sat == sat && cache->satColor[slot].index == index)
+    return cache->satColor[slot].color;
+  uint32_t color = desaturate(psCachedPaletteColor(cache, index, lookup), sat);
+  if (cache) {
+    cache->satColor[slot].color = color;
+    cache->satColor[slot].index = index;
+    cache->satColor[slot].sat = sat;
+  }
+  return color;
+}
+
+#endif
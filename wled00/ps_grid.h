@@ -0,0 +1,81 @@
+#pragma once
+#ifndef WLED_PS_GRID_H
+#define WLED_PS_GRID_H
+/*
+ * Uniform grid (counting sort) used by the 2D particle system for collision detection and tile ordered rendering
+ * kept free of Arduino dependencies so it can be verified on the host (tools/ps_grid_test.cpp)
+ * scratch layout: numCells + 1 cell start indices followed by the particle indices sorted by cell
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define PS_GRID_SKIP 0xFFFFFFFFUL // cellOf() result of particles that are not sorted
+
+// grid covering 0..maxX / 0..maxY with cells of at least 1 << shift sub-pixels and no more than maxCells cells,
+// returns the cell shift (cell size may be increased on large matrices)
+static inline uint32_t psGridSize(int32_t maxX, int32_t maxY, uint32_t shift, uint32_t maxCells, uint32_t &gridW, uint32_t &gridH) {
+  gridW = (maxX >> shift) + 1;
+  gridH = (maxY >> shift) + 1;
+  while (gridW * gridH > maxCells) {
+    shift++;
+    gridW = (maxX >> shift) + 1;
+    gridH = (maxY >> shift) + 1;
+  }
+  return shift;
+}
+
+// sorts particles 0..count-1 by cellOf(i), cellStart[c]..cellStart[c+1] are the indices into sorted of cell c
+// particles keep their order within a cell, returns the number of sorted particles
+template<class C>
+static inline uint32_t psGridSort(uint16_t *cellStart, uint16_t *sorted, uint32_t numCells, uint32_t count, C cellOf) {
+  memset(cellStart, 0, (numCells + 1) * sizeof(uint16_t));
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t c = cellOf(i);
+    if (c != PS_GRID_SKIP) cellStart[c]++;
+  }
+  // prefix sum gives cell end, filling backwards leaves cell start
+  uint32_t sum = 0;
+  for (uint32_t c = 0; c <= numCells; c++) {
+    sum += cellStart[c];
+    cellStart[c] = sum;
+  }
+  for (uint32_t i = count; i-- > 0;) {
+    uint32_t c = cellOf(i);
+    if (c != PS_GRID_SKIP) sorted[--cellStart[c]] = i;
+  }
+  return sum;
+}
+
+// calls pair(i, j) once for every two sorted particles in the same or in adjacent cells (own cell plus right, lower-left,
+// lower and lower-right neighbour), i.e. for every pair closer than the cell size in both x and y
+template<class P>
+static inline void psGridPairs(const uint16_t *cellStart, const uint16_t *sorted, uint32_t gridW, uint32_t gridH, P pair) {
+  constexpr int8_t neighbourOffsets[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+  for (uint32_t cy = 0; cy < gridH; cy++) {
+    for (uint32_t cx = 0; cx < gridW; cx++) {
+      const uint32_t cell = cy * gridW + cx;
+      const uint32_t start = cellStart[cell];
+      const uint32_t end = cellStart[cell + 1];
+      for (uint32_t i = start; i < end; i++) {
+        const uint32_t idx_i = sorted[i];
+        for (int n = -1; n < 4; n++) {
+          uint32_t jStart, jEnd;
+          if (n < 0) { // own cell, check against following particles
+            jStart = i + 1;
+            jEnd = end;
+          } else {
+            int32_t nx = (int32_t)cx + neighbourOffsets[n][0];
+            int32_t ny = (int32_t)cy + neighbourOffsets[n][1];
+            if (nx < 0 || nx >= (int32_t)gridW || ny >= (int32_t)gridH) continue;
+            jStart = cellStart[ny * gridW + nx];
+            jEnd = cellStart[ny * gridW + nx + 1];
+          }
+          for (uint32_t j = jStart; j < jEnd; j++) pair(idx_i, sorted[j]);
+        }
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+#ifndef WLED_PS_MOVE_H
+#define WLED_PS_MOVE_H
+/*
+ * Particle motion helpers shared by the 1D and 2D particle systems and the batched 2D move kernel
+ * kept free of Arduino dependencies so they can be verified and benchmarked on the host (tools/ps_move_test.cpp)
+ */
+#include <stdint.h>
+#include <stdlib.h>
+
+#define PS_P_MAXSPEED 120 // maximum speed a particle can have (vx/vy is int8)
+
+// limit speed of particles (used in 1D and 2D)
+static inline int32_t limitSpeed(const int32_t speed) {
+  return speed > PS_P_MAXSPEED ? PS_P_MAXSPEED : (speed < -PS_P_MAXSPEED ? -PS_P_MAXSPEED : speed); // note: this is slightly faster than using min/max at the cost of 50bytes of flash
+}
+
+// calculate the delta speed (dV) value and update the counter for force calculation (is used several times, function saves on codesize)
+// force is in 3.4 fixedpoint notation, +/-127
+static inline int32_t calcForce_dv(const int8_t force, uint8_t &counter) {
+  if (force == 0)
+    return 0;
+  // for small forces, need to use a delay counter
+  int32_t force_abs = abs(force); // absolute value (faster than lots of if's only 7 instructions)
+  int32_t dv = 0;
+  // for small forces, need to use a delay counter, apply force only if it overflows
+  if (force_abs < 16) {
+    counter += force_abs;
+    if (counter > 15) {
+      counter -= 16;
+      dv = force < 0 ? -1 : 1; // force is either 1 or -1 if it is small (zero force is handled above)
+    }
+  }
+  else
+    dv = force / 16; // MSBs, note: cannot use bitshift as dv can be negative
+
+  return dv;
+}
+
+// check if particle is out of bounds and wrap it around if required, returns false if out of bounds
+static inline bool checkBoundsAndWrap(int32_t &position, const int32_t max, const int32_t particleradius, const bool wrap) {
+  if ((uint32_t)position > (uint32_t)max) { // check if particle reached an edge, cast to uint32_t to save negative checking (max is always positive)
+    if (wrap) {
+      position = position % (max + 1); // note: cannot optimize modulo, particles can be far out of bounds when wrap is enabled
+      if (position < 0)
+        position += max + 1;
+    }
+    else if (((position < -particleradius) || (position > max + particleradius))) // particle is leaving boundaries, out of bounds if it has fully left
+      return false; // out of bounds
+  }
+  return true; // particle is in bounds
+}
+
+// system settings read once per frame by psMoveParticles()
+typedef struct {
+  int32_t maxX, maxY;   // last sub-pixel position
+  int32_t hardRadius;   // wall bounce distance
+  int32_t renderRadius; // distance a particle may leave the frame before it is out of bounds
+  bool colorByAge, bounceX, bounceY, wrapX, wrapY, killoutofbounds, useGravity;
+} PSMoveSettings;
+
+// moves, ages and bounces/wraps count particles that all use the same settings (see ParticleSystem2D::particleMoveUpdate())
+// bounce(incomingspeed, parallelspeed, position, maxposition) is the system's wall bounce
+template<class P, class F, class B>
+static inline void psMoveParticles(P *particles, F *flags, const uint32_t count, const PSMoveSettings &s, B bounce) {
+  const int32_t xLimit = s.maxX - s.hardRadius; // bounce limits
+  const int32_t yLimit = s.maxY - s.hardRadius;
+  for (uint32_t i = 0; i < count; i++) {
+    P &part = particles[i];
+    if (part.ttl == 0)
+      continue;
+    if (!flags[i].perpetual)
+      part.ttl--; // age
+    if (s.colorByAge)
+      part.hue = part.ttl < 255 ? part.ttl : 255; //set color to ttl
+
+    int32_t newX = part.x + (int32_t)part.vx;
+    int32_t newY = part.y + (int32_t)part.vy;
+    bool outofbounds = false;
+
+    if (s.bounceY && ((newY < s.hardRadius) || ((newY > yLimit) && !s.useGravity))) // reached floor / ceiling
+      bounce(part.vy, part.vx, newY, s.maxY);
+
+    if (!checkBoundsAndWrap(newY, s.maxY, s.renderRadius, s.wrapY)) { // note: this must not be skipped (see particleMoveUpdate())
+      outofbounds = true;
+      if (s.killoutofbounds && (newY < 0 || !s.useGravity)) // if gravity is enabled, only kill particles below ground
+        part.ttl = 0;
+    }
+
+    if (part.ttl) { //check x direction only if still alive
+      if (s.bounceX) {
+        if ((newX < s.hardRadius) || (newX > xLimit)) // reached a wall
+          bounce(part.vx, part.vy, newX, s.maxX);
+      }
+      else if (!checkBoundsAndWrap(newX, s.maxX, s.renderRadius, s.wrapX)) {
+        outofbounds = true;
+        if (s.killoutofbounds)
+          part.ttl = 0;
+      }
+    }
+
+    flags[i].outofbounds = outofbounds;
+    part.x = (int16_t)newX; // set new position
+    part.y = (int16_t)newY;
+  }
+}
+
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+#ifndef WLED_QUALITY_H
+#define WLED_QUALITY_H
+/*
+ * Adaptive effect quality controller (see WS2812FX::service())
+ * kept free of Arduino dependencies so it can be verified against a synthetic load on the host (tools/quality_test.cpp)
+ */
+#include <stdint.h>
+
+// adaptive quality: lowest quality level effects are scaled to (255 = full quality)
+#ifndef QUALITY_LEVEL_MIN
+  #define QUALITY_LEVEL_MIN 64
+#endif
+
+// the level drops fast if effects take longer than their share of the frame time and recovers slowly if there is enough
+// headroom (the gap between both thresholds avoids oscillation), effects scale their workload by QUALITY_LEVEL
+static inline uint8_t nextQualityLevel(unsigned quality, const unsigned effectTime, const unsigned frameTime) {
+  const unsigned budget = (frameTime * 1000 * 13) >> 4; // ~80% of frame time (in us), leave time for show()
+  if (effectTime > budget) {
+    unsigned target = (quality * budget) / effectTime; // workload is roughly proportional to quality level
+    unsigned step = quality - (quality >> 3) - 1;      // limit step size
+    quality = target > step ? target : step;
+    if (quality < QUALITY_LEVEL_MIN) quality = QUALITY_LEVEL_MIN;
+  }
+  else if (effectTime < (budget >> 1) + (budget >> 3)) // below ~50% of frame time
+    quality = quality + 2 < 255 ? quality + 2 : 255;
+  return quality;
+}
+
+// one controller step per shown frame: effectTime (us) is the time spent in effect functions this frame,
+// smoothedTime keeps the smoothed effect time between calls
+static inline uint8_t updateQualityLevel(uint8_t quality, uint32_t &smoothedTime, const uint32_t effectTime, const unsigned frameTime) {
+  smoothedTime = (smoothedTime * 3 + effectTime) >> 2; // smooth out single slow frames
+  unsigned next = nextQualityLevel(quality, smoothedTime, frameTime);
+  if (next < quality) smoothedTime = (smoothedTime * next) / quality; // expected time at new level, avoids overshooting due to smoothing lag
+  return next;
+}
+
+#endif
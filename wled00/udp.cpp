@@ -557,6 +557,12 @@ void handleNotifications()
     return;
   }
 
+  //binary control message (only on the notifier port and only if realtime/direct control is allowed, like UDP realtime)
+  if (!isSupp && udpIn[0] == CONTROL_PROTOCOL_ID) {
+    if (receiveDirect) handleControlPacket(udpIn, len);
+    return;
+  }
+
   //wled notifier, ignore if realtime packets active
   if (udpIn[0] == 0 && !realtimeMode && receiveGroups)
   {
@@ -663,6 +669,71 @@ void handleNotifications()
 }
 
 
+/*********************************************************************************************\
+   Binary control messages for high rate parameter updates (faders, MIDI controllers)
+   applied directly to segments, bypassing JSON parsing and the JSON buffer lock
+   accepted via WebSocket and, if "Receive UDP realtime" (receiveDirect) is enabled, on the UDP notifier port
+   [0] CONTROL_PROTOCOL_ID
+   [1] segment id (CTRL_ALL_SELECTED for all selected segments)
+   [2..] any number of field (CTRL_*) and value pairs, value is 4 bytes (RGBW) for colors, 1 byte otherwise
+   returns true if data was a control message
+\*********************************************************************************************/
+bool handleControlPacket(const uint8_t *data, size_t len, byte callMode)
+{
+  if (len < 2 || data[0] != CONTROL_PROTOCOL_ID) return false;
+  unsigned segId = data[1];
+  bool changed = false;
+
+  for (size_t i = 2; i < len; ) {
+    uint8_t field = data[i++];
+    if (field < CTRL_BRI || field > CTRL_COL3) break; // unknown field, value size unknown
+    size_t size = field >= CTRL_COL1 ? 4 : 1;
+    if (i + size > len) break; // truncated
+    const uint8_t *val = &data[i];
+    i += size;
+
+    if (field == CTRL_BRI) {
+      bri = val[0];
+      changed = true;
+      continue;
+    }
+    for (size_t s = 0; s < strip.getSegmentsNum(); s++) {
+      Segment &seg = strip.getSegment(s);
+      if (!seg.isActive() || (segId == CTRL_ALL_SELECTED ? !seg.isSelected() : s != segId)) continue;
+      switch (field) {
+        case CTRL_SEG_BRI:
+          if (val[0]) seg.setOpacity(val[0]); // use transition
+          seg.setOption(SEG_OPTION_ON, val[0]);
+          break;
+        case CTRL_SEG_ON:    seg.setOption(SEG_OPTION_ON, val[0]);  break;
+        case CTRL_SPEED:     seg.speed     = val[0];                break;
+        case CTRL_INTENSITY: seg.intensity = val[0];                break;
+        case CTRL_CUSTOM1:   seg.custom1   = val[0];                break;
+        case CTRL_CUSTOM2:   seg.custom2   = val[0];                break;
+        case CTRL_CUSTOM3:   seg.custom3   = MIN(val[0], 31);       break;
+        case CTRL_PALETTE:
+          if (seg.getLightCapabilities() & 1) seg.setPalette(val[0]); // ignore palette for White and On/Off segments
+          break;
+        case CTRL_EFFECT:
+          if (val[0] < strip.getModeCount() && val[0] != seg.mode) seg.setMode(val[0]);
+          break;
+        default: // colors
+          seg.setColor(field - CTRL_COL1, RGBW32(val[0], val[1], val[2], val[3])); // use transition
+          if (seg.mode == FX_MODE_STATIC) strip.trigger(); //instant refresh
+          break;
+      }
+      changed = true;
+    }
+  }
+
+  if (changed) {
+    stateChanged = true;
+    stateUpdated(callMode);
+  }
+  return true;
+}
+
+
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
 {
   unsigned pix = i + arlsOffset;
@@ -1,6 +1,7 @@
 #include "wled.h"
 #include "fcn_declare.h"
 #include "const.h"
+#include "perlin.h"
 #ifdef ESP8266
 #include "user_interface.h" // for bootloop detection
 #else
@@ -160,32 +161,66 @@ bool isAsterisksOnly(const char* str, byte maxLen)
 }
 
 
+static JSONLockStats jsonLockStats = {0};
+
+#if WLED_JSON_POOL_SIZE > 0
+// additional documents for requests that only serialize, so several of them (i.e. GET /json responses still being sent)
+// do not have to wait for each other or hold pDoc
+// a lease also holds jsonBufferLockMutex: serializing state must not overlap with code holding the JSON buffer lock in
+// another task (presets, deserializeState()) as it may modify or reallocate segments
+static JsonDocument *jsonPool[WLED_JSON_POOL_SIZE] = {nullptr};
+static volatile uint8_t jsonPoolOwner[WLED_JSON_POOL_SIZE] = {0}; // moduleID of the lease holder, 0 = free
+static portMUX_TYPE jsonPoolMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
 //threading/network callback details: https://github.com/wled-dev/WLED/pull/2336#discussion_r762276994
-bool requestJSONBufferLock(uint8_t moduleID)
+//if wait is false the lock is only taken if it is free (caller has an alternative, i.e. a previous snapshot)
+bool requestJSONBufferLock(uint8_t moduleID, bool wait)
 {
   if (pDoc == nullptr) {
     DEBUG_PRINTLN(F("ERROR: JSON buffer not allocated!"));
     return false;
   }
 
+  jsonLockStats.requests++;
+  unsigned long now = millis();
+  bool contended = false;
 #if defined(ARDUINO_ARCH_ESP32)
   // Use a recursive mutex type in case our task is the one holding the JSON buffer.
   // This can happen during large JSON web transactions.  In this case, we continue immediately
   // and then will return out below if the lock is still held.
-  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) return false;  // timed out waiting
+  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 0) == pdFALSE) {
+    contended = true;
+    if (!wait || xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) {  // timed out waiting
+      unsigned long waited = millis() - now;
+      jsonLockStats.contended++;
+      jsonLockStats.failed++;
+      jsonLockStats.waitTotal += waited;
+      if (waited > jsonLockStats.waitMax) jsonLockStats.waitMax = waited;
+      return false;
+    }
+  }
 #elif defined(ARDUINO_ARCH_ESP8266)
+  contended = jsonBufferLock;
   // If we're in system context, delay() won't return control to the user context, so there's
   // no point in waiting.
-  if (can_yield()) {
-    unsigned long now = millis();
+  if (wait && can_yield()) {
     while (jsonBufferLock && (millis()-now < 250)) delay(1); // wait for fraction for buffer lock
   }
 #else
   #error Unsupported task framework - fix requestJSONBufferLock
 #endif  
   // If the lock is still held - by us, or by another task
+  if (jsonBufferLock) contended = true;
+  if (contended) {
+    unsigned long waited = millis() - now;
+    jsonLockStats.contended++;
+    jsonLockStats.waitTotal += waited;
+    if (waited > jsonLockStats.waitMax) jsonLockStats.waitMax = waited;
+  }
   if (jsonBufferLock) {
     DEBUG_PRINTF_P(PSTR("ERROR: Locking JSON buffer (%d) failed! (still locked by %d)\n"), moduleID, jsonBufferLock);
+    jsonLockStats.failed++;
 #ifdef ARDUINO_ARCH_ESP32
     xSemaphoreGiveRecursive(jsonBufferLockMutex);
 #endif
@@ -209,6 +244,102 @@ void releaseJSONBufferLock()
 }
 
 
+// allocate pool documents (same capacity as pDoc), PSRAM is used if available, DRAM only if there is plenty of it
+void initJSONDocumentPool()
+{
+#if WLED_JSON_POOL_SIZE > 0
+  for (unsigned i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    JsonDocument *doc = nullptr;
+  #if defined(BOARD_HAS_PSRAM)
+    if (psramFound()) doc = new PSRAMDynamicJsonDocument(2 * JSON_BUFFER_SIZE);
+    else
+  #endif
+    if (getContiguousFreeHeap() > JSON_BUFFER_SIZE + 4*MIN_HEAP_SIZE) doc = new DynamicJsonDocument(JSON_BUFFER_SIZE);
+    if (doc && doc->capacity() == 0) { delete doc; doc = nullptr; } // allocation failed
+    if (!doc) break;
+    jsonPool[i] = doc;
+    jsonLockStats.poolSize++;
+  }
+  DEBUG_PRINTF_P(PSTR("JSON document pool: %u/%u\n"), jsonLockStats.poolSize, WLED_JSON_POOL_SIZE);
+#endif
+}
+
+
+// lease a JSON document for a request that does not depend on pDoc content (i.e. serialization of state/info)
+// falls back to the global buffer (and its lock) if no pool document is free; returns nullptr on failure
+// lease must be returned using releaseJSONDocument() from the same task
+// if wait is false it fails immediately instead of waiting for a writer in another task
+JsonDocument *requestJSONDocument(uint8_t moduleID, bool wait)
+{
+#if WLED_JSON_POOL_SIZE > 0
+  JsonDocument *doc = nullptr;
+  unsigned slot = 0;
+  portENTER_CRITICAL(&jsonPoolMux);
+  for (; slot < jsonLockStats.poolSize; slot++) {
+    if (!jsonPoolOwner[slot]) {
+      jsonPoolOwner[slot] = moduleID ? moduleID : 255;
+      doc = jsonPool[slot];
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&jsonPoolMux);
+  if (doc) {
+    // exclude writers in other tasks (recursive: readers in the same task or a lock held by this task do not block)
+    unsigned long now = millis();
+    bool contended = xSemaphoreTakeRecursive(jsonBufferLockMutex, 0) == pdFALSE;
+    bool acquired = !contended || (wait && xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdTRUE);
+    portENTER_CRITICAL(&jsonPoolMux); // stats are also updated by other tasks
+    if (contended) {
+      unsigned long waited = millis() - now;
+      jsonLockStats.contended++;
+      jsonLockStats.waitTotal += waited;
+      if (waited > jsonLockStats.waitMax) jsonLockStats.waitMax = waited;
+    }
+    if (acquired) jsonLockStats.leases++;
+    else {
+      jsonLockStats.failed++;
+      jsonPoolOwner[slot] = 0;
+    }
+    portEXIT_CRITICAL(&jsonPoolMux);
+    if (!acquired) {
+      DEBUG_PRINTF_P(PSTR("ERROR: Leasing JSON document (%d) failed! (locked by %d)\n"), moduleID, jsonBufferLock);
+      return nullptr;
+    }
+    DEBUG_PRINTF_P(PSTR("JSON document leased. (%d)\n"), moduleID);
+    doc->clear();
+    return doc;
+  }
+#endif
+  return requestJSONBufferLock(moduleID, wait) ? pDoc : nullptr;
+}
+
+
+void releaseJSONDocument(JsonDocument *doc)
+{
+  if (doc == nullptr) return;
+  if (doc == pDoc) {
+    releaseJSONBufferLock();
+    return;
+  }
+#if WLED_JSON_POOL_SIZE > 0
+  for (unsigned i = 0; i < jsonLockStats.poolSize; i++) {
+    if (jsonPool[i] == doc) {
+      DEBUG_PRINTF_P(PSTR("JSON document released. (%d)\n"), jsonPoolOwner[i]);
+      jsonPoolOwner[i] = 0;
+      xSemaphoreGiveRecursive(jsonBufferLockMutex);
+      break;
+    }
+  }
+#endif
+}
+
+
+const JSONLockStats& getJSONLockStats()
+{
+  return jsonLockStats;
+}
+
+
 // extracts effect mode (or palette) name from names serialized string
 // caller must provide large enough buffer for name (including SR extensions)!
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen)
@@ -953,153 +1084,19 @@ void handleBootLoop() {
 }
 
 /*
- * Fixed point integer based Perlin noise functions by @dedehai
- * Note: optimized for speed and to mimic fastled inoise functions, not for accuracy or best randomness
+ * Fixed point integer based Perlin noise functions by @dedehai, see perlin.h
  */
-#define PERLIN_SHIFT 1
-
-// calculate gradient for corner from hash value
-static inline __attribute__((always_inline)) int32_t hashToGradient(uint32_t h) {
-  // using more steps yields more "detailed" perlin noise but looks less like the original fastled version (adjust PERLIN_SHIFT to compensate, also changes range and needs proper adustment)
-  // return (h & 0xFF) - 128; // use PERLIN_SHIFT 7
-  // return (h & 0x0F) - 8; // use PERLIN_SHIFT 3
-  // return (h & 0x07) - 4; // use PERLIN_SHIFT 2
-  return (h & 0x03) - 2; // use PERLIN_SHIFT 1 -> closest to original fastled version
-}
-
-// Gradient functions for 1D, 2D and 3D Perlin noise  note: forcing inline produces smaller code and makes it 3x faster!
-static inline __attribute__((always_inline)) int32_t gradient1D(uint32_t x0, int32_t dx) {
-  uint32_t h = x0 * 0x27D4EB2D;
-  h ^= h >> 15;
-  h *= 0x92C3412B;
-  h ^= h >> 13;
-  h ^= h >> 7;
-  return (hashToGradient(h) * dx) >> PERLIN_SHIFT;
-}
-
-static inline __attribute__((always_inline)) int32_t gradient2D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy) {
-  uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D);
-  h ^= h >> 15;
-  h *= 0x92C3412B;
-  h ^= h >> 13;
-  return (hashToGradient(h) * dx + hashToGradient(h>>PERLIN_SHIFT) * dy) >> (1 + PERLIN_SHIFT);
-}
-
-static inline __attribute__((always_inline)) int32_t gradient3D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy, uint32_t z0, int32_t dz) {
-  // fast and good entropy hash from corner coordinates
-  uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D) ^ (z0 * 0x1B56C4E9);
-  h ^= h >> 15;
-  h *= 0x92C3412B;
-  h ^= h >> 13;
-  return ((hashToGradient(h) * dx + hashToGradient(h>>(1+PERLIN_SHIFT)) * dy + hashToGradient(h>>(1 + 2*PERLIN_SHIFT)) * dz) * 85) >> (8 + PERLIN_SHIFT); // scale to 16bit, x*85 >> 8 = x/3
-}
-
-// fast cubic smoothstep: t*(3 - 2t²), optimized for fixed point, scaled to avoid overflows
-static uint32_t smoothstep(const uint32_t t) {
-  uint32_t t_squared = (t * t) >> 16;
-  uint32_t factor = (3 << 16) - ((t << 1));
-  return (t_squared * factor) >> 18; // scale to avoid overflows and give best resolution
-}
-
-// simple linear interpolation for fixed-point values, scaled for perlin noise use
-static inline int32_t lerpPerlin(int32_t a, int32_t b, int32_t t) {
-    return a + (((b - a) * t) >> 14); // match scaling with smoothstep to yield 16.16bit values
-}
-
-// 1D Perlin noise function that returns a value in range of -24691 to 24689
+// raw noise
 int32_t perlin1D_raw(uint32_t x, bool is16bit) {
-  // integer and fractional part coordinates
-  int32_t x0 = x >> 16;
-  int32_t x1 = x0 + 1;
-  if(is16bit) x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
-
-  int32_t dx0 = x & 0xFFFF;
-  int32_t dx1 = dx0 - 0x10000;
-  // gradient values for the two corners
-  int32_t g0 = gradient1D(x0, dx0);
-  int32_t g1 = gradient1D(x1, dx1);
-  // interpolate and smooth function
-  int32_t tx = smoothstep(dx0);
-  int32_t noise = lerpPerlin(g0, g1, tx);
-  return noise;
+  return perlin1DNoise(x, is16bit);
 }
 
-// 2D Perlin noise function that returns a value in range of -20633 to 20629
 int32_t perlin2D_raw(uint32_t x, uint32_t y, bool is16bit) {
-  int32_t x0 = x >> 16;
-  int32_t y0 = y >> 16;
-  int32_t x1 = x0 + 1;
-  int32_t y1 = y0 + 1;
-
-  if(is16bit) {
-    x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
-    y1 = y1 & 0xFF;
-  }
-
-  int32_t dx0 = x & 0xFFFF;
-  int32_t dy0 = y & 0xFFFF;
-  int32_t dx1 = dx0 - 0x10000;
-  int32_t dy1 = dy0 - 0x10000;
-
-  int32_t g00 = gradient2D(x0, dx0, y0, dy0);
-  int32_t g10 = gradient2D(x1, dx1, y0, dy0);
-  int32_t g01 = gradient2D(x0, dx0, y1, dy1);
-  int32_t g11 = gradient2D(x1, dx1, y1, dy1);
-
-  uint32_t tx = smoothstep(dx0);
-  uint32_t ty = smoothstep(dy0);
-
-  int32_t nx0 = lerpPerlin(g00, g10, tx);
-  int32_t nx1 = lerpPerlin(g01, g11, tx);
-
-  int32_t noise = lerpPerlin(nx0, nx1, ty);
-  return noise;
+  return perlin2DNoise(x, y, is16bit);
 }
 
-// 3D Perlin noise function that returns a value in range of -16788 to 16381
 int32_t perlin3D_raw(uint32_t x, uint32_t y, uint32_t z, bool is16bit) {
-  int32_t x0 = x >> 16;
-  int32_t y0 = y >> 16;
-  int32_t z0 = z >> 16;
-  int32_t x1 = x0 + 1;
-  int32_t y1 = y0 + 1;
-  int32_t z1 = z0 + 1;
-
-  if(is16bit) {
-    x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
-    y1 = y1 & 0xFF;
-    z1 = z1 & 0xFF;
-  }
-
-  int32_t dx0 = x & 0xFFFF;
-  int32_t dy0 = y & 0xFFFF;
-  int32_t dz0 = z & 0xFFFF;
-  int32_t dx1 = dx0 - 0x10000;
-  int32_t dy1 = dy0 - 0x10000;
-  int32_t dz1 = dz0 - 0x10000;
-
-  int32_t g000 = gradient3D(x0, dx0, y0, dy0, z0, dz0);
-  int32_t g001 = gradient3D(x0, dx0, y0, dy0, z1, dz1);
-  int32_t g010 = gradient3D(x0, dx0, y1, dy1, z0, dz0);
-  int32_t g011 = gradient3D(x0, dx0, y1, dy1, z1, dz1);
-  int32_t g100 = gradient3D(x1, dx1, y0, dy0, z0, dz0);
-  int32_t g101 = gradient3D(x1, dx1, y0, dy0, z1, dz1);
-  int32_t g110 = gradient3D(x1, dx1, y1, dy1, z0, dz0);
-  int32_t g111 = gradient3D(x1, dx1, y1, dy1, z1, dz1);
-
-  uint32_t tx = smoothstep(dx0);
-  uint32_t ty = smoothstep(dy0);
-  uint32_t tz = smoothstep(dz0);
-
-  int32_t nx0 = lerpPerlin(g000, g100, tx);
-  int32_t nx1 = lerpPerlin(g010, g110, tx);
-  int32_t nx2 = lerpPerlin(g001, g101, tx);
-  int32_t nx3 = lerpPerlin(g011, g111, tx);
-  int32_t ny0 = lerpPerlin(nx0, nx1, ty);
-  int32_t ny1 = lerpPerlin(nx2, nx3, ty);
-
-  int32_t noise = lerpPerlin(ny0, ny1, tz);
-  return noise;
+  return perlin3DNoise(x, y, z, is16bit);
 }
 
 // scaling functions for fastled replacement
@@ -1125,4 +1122,33 @@ uint8_t perlin8(uint16_t x, uint16_t y) {
 
 uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z) {
   return (((perlin3D_raw((uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8, true) * 2015) >> 10) + 33168) >> 8; //scale to 16 bit, offset, then scale to 8bit
-}
\ No newline at end of file
+}
+
+// batch noise for rows of samples, see perlin.h
+// out[i] = perlin16(x + i*dx, y)
+void perlin16Row(uint16_t *out, unsigned count, uint32_t x, uint32_t dx, uint32_t y) {
+  uint32_t xi = x - dx;
+  perlin2DRow_raw(count, [&]() { return xi += dx; }, y, false,
+                  [&](unsigned i, int32_t n) { out[i] = ((n * 1537) >> 10) + 32725; });
+}
+
+// out[i] = perlin16(x + i*dx, y, z)
+void perlin16Row(uint16_t *out, unsigned count, uint32_t x, uint32_t dx, uint32_t y, uint32_t z) {
+  uint32_t xi = x - dx;
+  perlin3DRow_raw(count, [&]() { return xi += dx; }, y, z, false,
+                  [&](unsigned i, int32_t n) { out[i] = ((n * 1731) >> 10) + 33147; });
+}
+
+// out[i] = perlin8(x + i*dx, y)
+void perlin8Row(uint8_t *out, unsigned count, uint16_t x, uint16_t dx, uint16_t y) {
+  uint16_t xi = x - dx;
+  perlin2DRow_raw(count, [&]() { xi += dx; return (uint32_t)xi << 8; }, (uint32_t)y << 8, true,
+                  [&](unsigned i, int32_t n) { out[i] = (((n * 1620) >> 10) + 32771) >> 8; });
+}
+
+// out[i] = perlin8(x + i*dx, y, z)
+void perlin8Row(uint8_t *out, unsigned count, uint16_t x, uint16_t dx, uint16_t y, uint16_t z) {
+  uint16_t xi = x - dx;
+  perlin3DRow_raw(count, [&]() { xi += dx; return (uint32_t)xi << 8; }, (uint32_t)y << 8, (uint32_t)z << 8, true,
+                  [&](unsigned i, int32_t n) { out[i] = (((n * 2015) >> 10) + 33168) >> 8; });
+}
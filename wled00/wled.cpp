@@ -133,6 +133,7 @@ void WLED::loop()
       delay(1); //required to make sure ESP enters modem sleep (see #1184)
     #endif
   }
+  BusManager::service(); // send frames deferred by busy buses (also in realtime mode)
   #ifdef WLED_DEBUG
   stripMillis = millis() - stripMillis;
   avgStripMillis += stripMillis;
@@ -205,6 +206,7 @@ void WLED::loop()
 
   yield();
   handleWs();
+  handleJsonCache();
 #if defined(STATUSLED)
   handleStatusLED();
 #endif
@@ -472,6 +474,8 @@ void WLED::setup()
   UsermodManager::setup();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
 
+  initJSONDocumentPool(); // after strip and usermods have taken their share of RAM
+
   if (needsCfgSave) serializeConfigToFS(); // usermods required new parameters; need to wait for strip to be initialised #4752
 
   if (strcmp(multiWiFi[0].clientSSID, DEFAULT_CLIENT_SSID) == 0 && !configBackupExists())
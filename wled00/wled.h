@@ -747,6 +747,7 @@ WLED_GLOBAL byte effectSpeed _INIT(128);
 WLED_GLOBAL byte effectIntensity _INIT(128);
 WLED_GLOBAL byte effectPalette _INIT(0);
 WLED_GLOBAL bool stateChanged _INIT(false);
+WLED_GLOBAL volatile uint32_t stateVersion _INIT(0); // incremented on every state update, used to validate cached /json/state responses
 
 // network
 #ifdef WLED_SAVE_RAM
@@ -882,6 +883,8 @@ WLED_GLOBAL Toki toki _INIT(Toki());
 WLED_GLOBAL size_t fsBytesUsed _INIT(0);
 WLED_GLOBAL size_t fsBytesTotal _INIT(0);
 WLED_GLOBAL unsigned long presetsModifiedTime _INIT(0L);
+WLED_GLOBAL volatile uint16_t presetsModifiedCount _INIT(0); // incremented (under JSON buffer lock) whenever presets.json is written (save, delete, upload, /edit, restore)
+WLED_GLOBAL volatile bool presetsFileChanged _INIT(false); // set by web server when an upload or /edit request finished
 WLED_GLOBAL bool doCloseFile _INIT(false);
 
 // presets
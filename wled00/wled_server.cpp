@@ -189,13 +189,16 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
 
     request->_tempFile = WLED_FS.open(finalname, "w");
     DEBUG_PRINTF_P(PSTR("Uploading %s\n"), finalname.c_str());
-    if (finalname.equals(FPSTR(getPresetsFileName()))) presetsModifiedTime = toki.second();
   }
   if (len) {
     request->_tempFile.write(data,len);
   }
   if (isFinal) {
     request->_tempFile.close();
+    if (filename.indexOf(F("presets.json")) >= 0) {
+      presetsModifiedTime = toki.second();
+      presetsFileChanged = true; // counted in loop() (see handlePresets())
+    }
     if (filename.indexOf(F("cfg.json")) >= 0) { // check for filename with or without slash
       doReboot = true;
       request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("Configuration restore successful.\nRebooting..."));
@@ -216,6 +219,12 @@ void createEditHandler(bool enable) {
       #else
       editHandler = &server.addHandler(new SPIFFSEditor("","",WLED_FS));//http_username,http_password));
       #endif
+      // files may be uploaded, created or deleted: assume presets.json changed once the request is finished
+      // (filter is evaluated for every request, the file is written after dispatch; counted in loop(), see handlePresets())
+      editHandler->setFilter([](AsyncWebServerRequest *request) {
+        if (request->method() != HTTP_GET && request->url().startsWith(F("/edit"))) request->onDisconnect([]() { presetsFileChanged = true; });
+        return true;
+      });
     #else
       editHandler = &server.on(F("/edit"), HTTP_GET, [](AsyncWebServerRequest *request){
         serveMessage(request, 501, FPSTR(s_notimplemented), F("The FS editor is disabled in this build."), 254);
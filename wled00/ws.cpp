@@ -10,6 +10,7 @@ constexpr uint8_t BINARY_PROTOCOL_GENERIC = 0xFF; // generic / auto detect NOT I
 constexpr uint8_t BINARY_PROTOCOL_E131    = P_E131; // = 0, untested!
 constexpr uint8_t BINARY_PROTOCOL_ARTNET  = P_ARTNET; // = 1, untested!
 constexpr uint8_t BINARY_PROTOCOL_DDP     = P_DDP; // = 2
+constexpr uint8_t BINARY_PROTOCOL_CONTROL = CONTROL_PROTOCOL_ID; // = 0xC5, see handleControlPacket()
 
 uint16_t wsLiveClientId = 0;
 unsigned long wsLastLiveTime = 0;
@@ -17,15 +18,216 @@ unsigned long wsLastLiveTime = 0;
 
 #define WS_LIVE_INTERVAL 40
 
+// binary control messages arrive in the async_tcp task while loop() may be rendering: they are queued and applied
+// from handleWs() like the UDP ones (handleNotifications()), a full queue drops messages (faders send again anyway)
+#ifndef WS_CONTROL_QUEUE
+  #define WS_CONTROL_QUEUE 8
+#endif
+#define WS_CONTROL_MAX_LEN 64 // longer messages are dropped (header and every field once is 37 bytes)
+typedef struct {
+  uint8_t len;
+  uint8_t data[WS_CONTROL_MAX_LEN];
+} WsControlMessage;
+static WsControlMessage wsControlQueue[WS_CONTROL_QUEUE];
+static volatile unsigned wsControlHead = 0, wsControlTail = 0; // written by async_tcp task / loop()
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE wsControlMux = portMUX_INITIALIZER_UNLOCKED;
+  #define WS_CONTROL_LOCK()   portENTER_CRITICAL(&wsControlMux)
+  #define WS_CONTROL_UNLOCK() portEXIT_CRITICAL(&wsControlMux)
+#else
+  #define WS_CONTROL_LOCK()
+  #define WS_CONTROL_UNLOCK()
+#endif
+
+static void queueWsControl(const uint8_t *data, size_t len) {
+  if (len > WS_CONTROL_MAX_LEN) return;
+  WS_CONTROL_LOCK();
+  if (wsControlHead - wsControlTail < WS_CONTROL_QUEUE) {
+    WsControlMessage &m = wsControlQueue[wsControlHead % WS_CONTROL_QUEUE];
+    memcpy(m.data, data, len);
+    m.len = len;
+    wsControlHead++;
+  }
+  WS_CONTROL_UNLOCK();
+}
+
+static void handleWsControl() {
+  while (wsControlTail != wsControlHead) {
+    WsControlMessage m;
+    WS_CONTROL_LOCK();
+    m = wsControlQueue[wsControlTail % WS_CONTROL_QUEUE];
+    wsControlTail++;
+    WS_CONTROL_UNLOCK();
+    handleControlPacket(m.data, m.len);
+  }
+}
+
+// state deltas: a client subscribes with {"diff":true} and acknowledges each received version with {"ack":<v>}
+// subscribed clients receive {"v":<v>,"b":<v-1>,"d":{<changed state keys>,"seg":[{"id":..,<changed fields>}]}}, one message
+// for each version since the one they acknowledged (the last WS_DELTA_HISTORY deltas are kept), clients ignore deltas
+// with a base other than their own version (i.e. if their acknowledgement was still in flight)
+// all others, subscribers that are too far behind and any client on connect or {"v":true} receive a full {"state","info"}
+// snapshot that includes "v"; a removed key (i.e. segment name) cannot be expressed as delta and makes all subscribers resync
+// fixed size table as it is updated from WS events while broadcasts iterate it (from loop)
+#ifndef WS_MAX_CLIENTS
+  #define WS_MAX_CLIENTS 8 // AsyncWebSocket default limit is lower on all platforms
+#endif
+#ifndef WS_DELTA_HISTORY
+  #ifdef ESP8266
+    #define WS_DELTA_HISTORY 2
+  #else
+    #define WS_DELTA_HISTORY 4
+  #endif
+#endif
+typedef struct {
+  uint32_t id;   // 0 = unused entry
+  uint32_t ack;  // last acknowledged state version
+  bool     diff; // subscribed to deltas
+} WsClient;
+static WsClient wsClients[WS_MAX_CLIENTS] = {};
+static uint32_t wsStateVersion = 0;     // version of last broadcast
+static bool     wsSnapshotValid = false; // hashes below describe wsStateVersion
+static std::vector<uint32_t> wsStateHashes;             // (key hash, value hash) pairs of top level state keys
+static std::vector<std::vector<uint32_t>> wsSegHashes;  // same for each segment id
+static std::vector<uint32_t> wsHashScratch;             // swapped with the hashes being rebuilt, keeps capacity between broadcasts
+static std::vector<bool> wsSegPresent;
+static DynamicJsonDocument *wsDeltaDoc = nullptr;       // allocated while someone subscribed
+typedef struct {
+  uint32_t version; // delta from version-1 to version, 0 = unused
+  String   json;
+} WsDelta;
+static WsDelta wsDeltas[WS_DELTA_HISTORY]; // indexed by version % WS_DELTA_HISTORY
+static uint32_t wsDeltasSent = 0, wsSnapshotsSent = 0; // broadcast statistics (debug output)
+
+static WsClient *findWsClient(uint32_t id) {
+  for (auto &c : wsClients) if (c.id == id) return &c;
+  return nullptr;
+}
+
+static void clearWsDeltas() {
+  for (auto &wd : wsDeltas) { wd.version = 0; wd.json = String(); } // release memory
+}
+
+// releases everything used for deltas once the last subscriber is gone
+static void releaseWsDiff() {
+  wsSnapshotValid = false;
+  clearWsDeltas();
+  delete wsDeltaDoc;
+  wsDeltaDoc = nullptr;
+  std::vector<uint32_t>().swap(wsStateHashes);
+  std::vector<uint32_t>().swap(wsHashScratch);
+  std::vector<std::vector<uint32_t>>().swap(wsSegHashes);
+  std::vector<bool>().swap(wsSegPresent);
+}
+
+static bool hasWsDiffClients() {
+  for (const auto &c : wsClients) if (c.id && c.diff) return true;
+  return false;
+}
+
+// FNV-1a hash of serialized JSON
+class HashPrint : public Print {
+  public:
+    uint32_t hash = 2166136261UL;
+    size_t write(uint8_t c) override { hash ^= c; hash *= 16777619UL; return 1; }
+    void add(const char *str) { while (*str) write(*str++); }
+};
+
+// adds values of src that differ from previous hashes to delta and replaces hashes with those of src
+// sets removed if a previously hashed key is missing in src
+static bool diffJsonObject(JsonObject src, JsonObject delta, std::vector<uint32_t> &hashes, bool &removed, const char *skip = nullptr) {
+  std::vector<uint32_t> &newHashes = wsHashScratch;
+  newHashes.clear();
+  bool changed = false;
+  for (JsonPair kv : src) {
+    if (skip && strcmp(kv.key().c_str(), skip) == 0) continue;
+    HashPrint key, val;
+    key.add(kv.key().c_str());
+    serializeJson(kv.value(), val);
+    newHashes.push_back(key.hash);
+    newHashes.push_back(val.hash);
+    bool found = false;
+    for (size_t i = 0; i < hashes.size(); i += 2) {
+      if (hashes[i] == key.hash) { found = hashes[i+1] == val.hash; break; }
+    }
+    if (!found) {
+      delta[kv.key()] = kv.value();
+      changed = true;
+    }
+  }
+  for (size_t i = 0; i < hashes.size() && !removed; i += 2) {
+    bool found = false;
+    for (size_t j = 0; j < newHashes.size() && !found; j += 2) found = newHashes[j] == hashes[i];
+    if (!found) removed = changed = true;
+  }
+  hashes.swap(newHashes); // old hashes become the next scratch buffer
+  return changed;
+}
+
+// builds delta from last broadcast state, returns true if there are any changes
+static bool diffStateWs(JsonObject state, JsonObject delta, bool &removed) {
+  bool changed = diffJsonObject(state, delta, wsStateHashes, removed, "seg");
+  JsonArray segs = state["seg"];
+  std::vector<bool> &present = wsSegPresent;
+  present.assign(wsSegHashes.size(), false);
+  for (JsonObject seg : segs) {
+    unsigned id = seg["id"];
+    if (id >= wsSegHashes.size()) { wsSegHashes.resize(id+1); present.resize(id+1, false); }
+    present[id] = true;
+    bool isNew = wsSegHashes[id].empty();
+    if (!delta.containsKey("seg")) delta.createNestedArray("seg");
+    JsonObject segDelta = delta["seg"].createNestedObject();
+    segDelta["id"] = id;
+    if (diffJsonObject(seg, segDelta, wsSegHashes[id], removed, "id") || isNew) changed = true;
+    else delta["seg"].as<JsonArray>().remove(delta["seg"].size()-1); // unchanged segment
+  }
+  for (size_t id = 0; id < wsSegHashes.size(); id++) {
+    if (present[id] || wsSegHashes[id].empty()) continue;
+    wsSegHashes[id].clear(); // segment was removed
+    if (!delta.containsKey("seg")) delta.createNestedArray("seg");
+    JsonObject segDelta = delta["seg"].createNestedObject();
+    segDelta["id"]   = id;
+    segDelta["stop"] = 0;
+    changed = true;
+  }
+  if (delta.containsKey("seg") && delta["seg"].size() == 0) delta.remove("seg");
+  return changed;
+}
+
+// true if a subscriber can be brought up to date with the kept deltas
+static bool hasWsDeltaChain(const WsClient &wc) {
+  if (!wc.diff || !wc.ack || wsStateVersion - wc.ack > WS_DELTA_HISTORY) return false;
+  for (uint32_t v = wc.ack + 1; v <= wsStateVersion; v++) if (wsDeltas[v % WS_DELTA_HISTORY].version != v) return false;
+  return true;
+}
+
+// handles {"ack":<version>} without taking the JSON buffer
+static bool handleWsAck(AsyncWebSocketClient * client, const uint8_t *data, size_t len) {
+  if (len < 8 || len > 20 || strncmp_P((const char*)data, PSTR("{\"ack\":"), 7) != 0) return false;
+  char num[16];
+  size_t n = std::min(len - 7, sizeof(num) - 1);
+  memcpy(num, data + 7, n);
+  num[n] = '\0';
+  WsClient *c = findWsClient(client->id());
+  if (c) c->ack = strtoul(num, nullptr, 10);
+  return true;
+}
+
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
   if(type == WS_EVT_CONNECT){
     //client connected
     DEBUG_PRINTLN(F("WS client connected."));
+    if (!findWsClient(client->id())) {
+      WsClient *c = findWsClient(0); // free entry
+      if (c) { c->ack = 0; c->diff = false; c->id = client->id(); }
+    }
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
     if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    WsClient *c = findWsClient(client->id());
+    if (c) { c->diff = false; c->id = 0; }
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
@@ -40,6 +242,7 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           client->text(F("pong"));
           return;
         }
+        if (handleWsAck(client, data, len)) return; // high rate, no reply needed
 
         bool verboseResponse = false;
         if (!requestJSONBufferLock(11)) {
@@ -58,6 +261,10 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           verboseResponse = true;
         } else if (root.containsKey("lv")) {
           wsLiveClientId = root["lv"] ? client->id() : 0;
+        } else if (root.containsKey(F("diff"))) {
+          WsClient *c = findWsClient(client->id());
+          if (c) c->diff = root[F("diff")];
+          verboseResponse = true; // (re)sync with a full snapshot
         } else {
           verboseResponse = deserializeState(root);
         }
@@ -88,6 +295,9 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           case BINARY_PROTOCOL_ARTNET:
             handleE131Packet((e131_packet_t*)&data[offset], client->remoteIP(), P_ARTNET);
             break;
+          case BINARY_PROTOCOL_CONTROL:
+            queueWsControl(data, len); // protocol byte is part of the message, applied from loop()
+            break;
           case BINARY_PROTOCOL_DDP:
             if (len < 10 + offset) return; // DDP header is 10 bytes (+1 protocol byte)
             size_t ddpDataLen = (data[8+offset] << 8) | data[9+offset]; // data length in bytes from DDP header
@@ -132,11 +342,33 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
   }
 }
 
+// sends each client the deltas since its acknowledged version, or the snapshot if they are no longer available
+// (snapshot is nullptr if the caller found every client could be served from deltas)
+static void sendWsDeltas(const char *snapshot, size_t len) {
+  for (const auto &wc : wsClients) {
+    AsyncWebSocketClient *c = wc.id ? ws.client(wc.id) : nullptr;
+    if (!c) continue;
+    if (wc.diff && wc.ack == wsStateVersion) continue; // up to date, nothing to send if only info changed
+    if (hasWsDeltaChain(wc)) {
+      for (uint32_t v = wc.ack + 1; v <= wsStateVersion; v++) {
+        const String &json = wsDeltas[v % WS_DELTA_HISTORY].json;
+        c->text(json.c_str(), json.length());
+      }
+      wsDeltasSent++;
+    } else if (snapshot) {
+      c->text(snapshot, len);
+      if (wc.diff) wsSnapshotsSent++;
+    }
+  }
+  DEBUG_PRINTF_P(PSTR("WS subscribers: %u delta, %u full updates sent\n"), wsDeltasSent, wsSnapshotsSent);
+}
+
 void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
 
-  if (!requestJSONBufferLock(12)) {
+  JsonDocument *doc = requestJSONDocument(12); // pool document if available, global buffer otherwise
+  if (!doc) {
     const char* error = PSTR("{\"error\":3}");
     if (client) {
       client->text(FPSTR(error)); // ERR_NOBUF
@@ -146,19 +378,62 @@ void sendDataWs(AsyncWebSocketClient * client)
     return;
   }
 
-  JsonObject state = pDoc->createNestedObject("state");
+  JsonObject state = doc->createNestedObject("state");
   serializeState(state);
-  JsonObject info  = pDoc->createNestedObject("info");
+
+  bool diffClients = hasWsDiffClients();
+  if (!client && !diffClients && wsDeltaDoc) releaseWsDiff(); // hashes and deltas are only maintained while someone subscribed
+  if (!client && diffClients) {
+    if (!wsDeltaDoc) wsDeltaDoc = new DynamicJsonDocument(1024);
+    wsDeltaDoc->clear();
+    JsonObject d = wsDeltaDoc->createNestedObject("d");
+    bool removed = false;
+    bool changed = diffStateWs(state, d, removed);
+    if (changed || !wsSnapshotValid) {
+      wsStateVersion++;
+      (*wsDeltaDoc)["v"] = wsStateVersion;
+      (*wsDeltaDoc)["b"] = wsStateVersion - 1;
+      if (wsSnapshotValid && !removed && !wsDeltaDoc->overflowed()) {
+        WsDelta &wd = wsDeltas[wsStateVersion % WS_DELTA_HISTORY];
+        wd.json = "";
+        serializeJson(*wsDeltaDoc, wd.json);
+        wd.version = wsStateVersion;
+      } else clearWsDeltas(); // subscribers have to resync
+    }
+    wsSnapshotValid = true;
+
+    // a broadcast that every client can receive as deltas does not need the full snapshot
+    bool snapshot = false;
+    for (const auto &wc : wsClients) {
+      if (!wc.id || (wc.diff && wc.ack == wsStateVersion) || hasWsDeltaChain(wc) || !ws.client(wc.id)) continue;
+      snapshot = true;
+      break;
+    }
+    if (!snapshot) {
+      releaseJSONDocument(doc);
+      DEBUG_PRINTLN(F("Sending WS deltas only."));
+      sendWsDeltas(nullptr, 0);
+      return;
+    }
+  }
+  JsonObject info  = doc->createNestedObject("info");
   serializeInfo(info);
+  // single client snapshot may be newer than last broadcast: version 0 makes the client resync on next broadcast
+  if (diffClients) (*doc)["v"] = client ? 0 : wsStateVersion;
+  if (diffClients && client) {
+    WsClient *c = findWsClient(client->id());
+    if (c) c->ack = 0; // (deltas based on its old version would be ignored)
+  }
 
-  size_t len = measureJson(*pDoc);
-  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), pDoc->memoryUsage(), len);
+  size_t len = measureJson(*doc);
+  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), doc->memoryUsage(), len);
 
   // the following may no longer be necessary as heap management has been fixed by @willmmiles in AWS
   size_t heap1 = getFreeHeapSize();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
   #ifdef ESP8266
   if (len>heap1) {
+    releaseJSONDocument(doc);
     DEBUG_PRINTLN(F("Out of memory (WS)!"));
     return;
   }
@@ -171,24 +446,29 @@ void sendDataWs(AsyncWebSocketClient * client)
   size_t heap2 = 0; // ESP32 variants do not have the same issue and will work without checking heap allocation
   #endif
   if (!buffer || heap1-heap2<len) {
-    releaseJSONBufferLock();
+    releaseJSONDocument(doc);
     DEBUG_PRINTLN(F("WS buffer allocation failed."));
     ws.closeAll(1013); //code 1013 = temporary overload, try again later
     ws.cleanupClients(0); //disconnect all clients to release memory
     return; //out of memory
   }
-  serializeJson(*pDoc, (char *)buffer.data(), len);
+  serializeJson(*doc, (char *)buffer.data(), len);
 
   DEBUG_PRINT(F("Sending WS data "));
   if (client) {
     DEBUG_PRINTLN(F("to a single client."));
     client->text(std::move(buffer));
-  } else {
+  } else if (!diffClients) {
     DEBUG_PRINTLN(F("to multiple clients."));
     ws.textAll(std::move(buffer));
+  } else {
+    DEBUG_PRINTLN(F("to multiple clients."));
+    releaseJSONDocument(doc);
+    sendWsDeltas((const char *)buffer.data(), len);
+    return;
   }
 
-  releaseJSONBufferLock();
+  releaseJSONDocument(doc);
 }
 
 bool sendLiveLedsWs(uint32_t wsClient)
@@ -252,6 +532,7 @@ bool sendLiveLedsWs(uint32_t wsClient)
 
 void handleWs()
 {
+  handleWsControl();
   if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
   {
     #ifdef ESP8266